@@ -0,0 +1,197 @@
+#pragma once
+
+#include "ratiocore_export.h"
+#include "riddle_parser.h"
+#include <ostream>
+#include <string_view>
+#include <cstdint>
+
+namespace ratio::core
+{
+  /**
+   * @brief The kinds of the nodes stored in a binary compilation unit.
+   *
+   */
+  enum class ast_kind : uint8_t
+  {
+    none,
+    // the expressions..
+    bool_literal_expression,
+    int_literal_expression,
+    real_literal_expression,
+    string_literal_expression,
+    cast_expression,
+    plus_expression,
+    minus_expression,
+    not_expression,
+    constructor_expression,
+    eq_expression,
+    neq_expression,
+    lt_expression,
+    leq_expression,
+    geq_expression,
+    gt_expression,
+    function_expression,
+    id_expression,
+    implication_expression,
+    disjunction_expression,
+    conjunction_expression,
+    exct_one_expression,
+    addition_expression,
+    subtraction_expression,
+    multiplication_expression,
+    division_expression,
+    // the statements..
+    local_field_statement,
+    assignment_statement,
+    expression_statement,
+    disjunction_statement,
+    conjunction_statement,
+    formula_statement,
+    return_statement,
+    // the type declarations..
+    typedef_declaration,
+    enum_declaration,
+    class_declaration
+  };
+
+  /**
+   * @brief Computes the 64-bit FNV-1a hash of the given content.
+   *
+   * @param content The content to hash.
+   * @return uint64_t The hash of the given content.
+   */
+  inline uint64_t content_hash(std::string_view content) noexcept
+  {
+    uint64_t h = 14695981039346656037ull;
+    for (const auto &c : content)
+    {
+      h ^= static_cast<unsigned char>(c);
+      h *= 1099511628211ull;
+    }
+    return h;
+  }
+
+  /**
+   * @brief Writes the nodes of a compilation unit in a compact binary format.
+   *
+   * Writers which omit the positions of the tokens produce the same bytes for nodes differing only in their placement within the source, as required to compare declarations across edits.
+   */
+  class ast_writer
+  {
+  public:
+    ast_writer(std::ostream &os, bool positions = true) : os(os), positions(positions) {}
+    ast_writer(const ast_writer &orig) = delete;
+
+    /**
+     * @brief Writes the header of a binary compilation unit, identifying the format and the parsed content.
+     *
+     * Along with its hash, which names the cache entries, the parsed content is stored, so that readers can tell hash collisions apart.
+     *
+     * @param content The parsed content.
+     */
+    RATIOCORE_EXPORT void write_header(std::string_view content);
+
+    RATIOCORE_EXPORT void write_kind(const ast_kind &k);
+    RATIOCORE_EXPORT void write_bool(const bool &b);
+    RATIOCORE_EXPORT void write_uint(uint64_t n);
+    RATIOCORE_EXPORT void write_int(const int64_t &n);
+    RATIOCORE_EXPORT void write_string(const std::string &str);
+    RATIOCORE_EXPORT void write_rational(const semitone::rational &r);
+
+    RATIOCORE_EXPORT void write_id(const riddle::id_token &id);
+    RATIOCORE_EXPORT void write_ids(const std::vector<riddle::id_token> &ids);
+    RATIOCORE_EXPORT void write_paths(const std::vector<std::vector<riddle::id_token>> &paths);
+    RATIOCORE_EXPORT void write_parameters(const std::vector<std::pair<const std::vector<riddle::id_token>, const riddle::id_token>> &pars);
+    RATIOCORE_EXPORT void write_bool_token(const riddle::bool_token &tk);
+    RATIOCORE_EXPORT void write_int_token(const riddle::int_token &tk);
+    RATIOCORE_EXPORT void write_real_token(const riddle::real_token &tk);
+    RATIOCORE_EXPORT void write_string_token(const riddle::string_token &tk);
+
+    RATIOCORE_EXPORT void write_expression(const std::unique_ptr<const riddle::ast::expression> &xpr);
+    RATIOCORE_EXPORT void write_expressions(const std::vector<std::unique_ptr<const riddle::ast::expression>> &xprs);
+    RATIOCORE_EXPORT void write_statement(const std::unique_ptr<const riddle::ast::statement> &stmnt);
+    RATIOCORE_EXPORT void write_statements(const std::vector<std::unique_ptr<const riddle::ast::statement>> &stmnts);
+
+  private:
+    void write_position(const riddle::token &tk);
+
+  private:
+    std::ostream &os;
+    const bool positions; // whether the positions of the tokens are written..
+  };
+
+  /**
+   * @brief Reads the nodes of a compilation unit written by an `ast_writer`.
+   *
+   * @throws std::invalid_argument Thrown if the data is malformed.
+   */
+  class ast_reader
+  {
+  public:
+    ast_reader(std::string_view data) : data(data) {}
+    ast_reader(const ast_reader &orig) = delete;
+
+    /**
+     * @brief Reads the header of a binary compilation unit, checking that it has been written by this version of the format for the given content.
+     *
+     * @param content The content whose compilation unit is desired.
+     * @return true If the data has been written by this version of the format for the given content.
+     * @return false If the data has been written by another version of the format or for a different content.
+     */
+    RATIOCORE_EXPORT bool read_header(std::string_view content);
+    RATIOCORE_EXPORT std::unique_ptr<const riddle::ast::compilation_unit> read_compilation_unit();
+
+  private:
+    ast_kind read_kind();
+    bool read_bool();
+    uint64_t read_uint();
+    int64_t read_int();
+    std::string read_string();
+    semitone::rational read_rational();
+
+    riddle::id_token read_id();
+    std::vector<riddle::id_token> read_ids();
+    std::vector<std::vector<riddle::id_token>> read_paths();
+    std::vector<std::pair<const std::vector<riddle::id_token>, const riddle::id_token>> read_parameters();
+
+    std::unique_ptr<const riddle::ast::expression> read_expression();
+    std::vector<std::unique_ptr<const riddle::ast::expression>> read_expressions();
+    std::unique_ptr<const riddle::ast::statement> read_statement();
+    std::vector<std::unique_ptr<const riddle::ast::statement>> read_statements();
+
+    std::unique_ptr<const riddle::ast::method_declaration> read_method_declaration();
+    std::unique_ptr<const riddle::ast::predicate_declaration> read_predicate_declaration();
+    std::unique_ptr<const riddle::ast::field_declaration> read_field_declaration();
+    std::unique_ptr<const riddle::ast::constructor_declaration> read_constructor_declaration();
+    std::unique_ptr<const riddle::ast::type_declaration> read_type_declaration();
+
+    struct position
+    {
+      size_t start_line, start_pos, end_line, end_pos;
+    };
+    position read_position();
+
+  private:
+    std::string_view data; // the data to read..
+    size_t pos = 0;        // the current reading position..
+  };
+
+  /**
+   * @brief Writes the given compilation unit, obtained by parsing the given content, in binary format.
+   *
+   * @param os The stream to write the compilation unit to.
+   * @param content The parsed content.
+   * @param cu The compilation unit to write.
+   */
+  RATIOCORE_EXPORT void write_compilation_unit(std::ostream &os, std::string_view content, const riddle::ast::compilation_unit &cu);
+  /**
+   * @brief Reads a compilation unit written in binary format.
+   *
+   * @param data The binary data.
+   * @param content The content whose compilation unit is desired.
+   * @return std::unique_ptr<const riddle::ast::compilation_unit> The compilation unit, or `nullptr` if the data has been written by another version of the format or for a different content.
+   * @throws std::invalid_argument Thrown if the data is malformed.
+   */
+  RATIOCORE_EXPORT std::unique_ptr<const riddle::ast::compilation_unit> read_compilation_unit(std::string_view data, std::string_view content);
+} // namespace ratio::core
@@ -0,0 +1,84 @@
+#pragma once
+#include "item.h"
+#include <vector>
+#include <utility>
+
+namespace ratio::core
+{
+  /**
+   * @brief The statistics of the call-site caches of a core.
+   *
+   */
+  struct call_cache_stats
+  {
+    size_t hits = 0;   // the number of calls whose overload has been found in the cache of their call-site..
+    size_t misses = 0; // the number of calls whose overload has been resolved..
+    unsigned epoch = 0; // incremented whenever the resolution of an overload might change (e.g., a new method or supertype), invalidating all the cached entries..
+
+    double hit_rate() const noexcept { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0; }
+  };
+
+  /**
+   * @brief A cache, local to a call-site, of the overloads (methods or constructors) resolved for the types of the arguments of the call.
+   *
+   * Up to `max_entries` argument-type tuples are cached, evicting the oldest one when full.
+   */
+  template <typename Tp>
+  class call_cache
+  {
+  public:
+    static constexpr size_t max_entries = 4;
+
+    /**
+     * @brief Returns the overload for the types of the given arguments, resolving and caching it if not cached yet.
+     *
+     * @param stats The statistics of the call-site caches, also holding their current epoch.
+     * @param args The arguments of the call.
+     * @param resolve The function resolving the overload given the types of the arguments.
+     * @return Tp& The overload for the types of the given arguments.
+     */
+    template <typename Resolver>
+    Tp &get(call_cache_stats &stats, const std::vector<expr> &args, Resolver resolve)
+    {
+      if (epoch != stats.epoch)
+      { // the cached entries might be stale..
+        entries.clear();
+        epoch = stats.epoch;
+      }
+
+      for (const auto &[par_types, tgt] : entries)
+        if (matches(par_types, args))
+        {
+          stats.hits++;
+          return *tgt;
+        }
+
+      stats.misses++;
+      std::vector<const type *> par_types;
+      par_types.reserve(args.size());
+      for (const auto &arg : args)
+        par_types.emplace_back(&arg->get_type());
+
+      Tp &tgt = resolve(par_types);
+      if (entries.size() == max_entries)
+        entries.erase(entries.cbegin());
+      entries.emplace_back(std::move(par_types), &tgt);
+      return tgt;
+    }
+
+  private:
+    static bool matches(const std::vector<const type *> &par_types, const std::vector<expr> &args) noexcept
+    {
+      if (par_types.size() != args.size())
+        return false;
+      for (size_t i = 0; i < args.size(); ++i)
+        if (par_types[i] != &args[i]->get_type())
+          return false;
+      return true;
+    }
+
+  private:
+    unsigned epoch = 0;                                          // the epoch of the cached entries..
+    std::vector<std::pair<std::vector<const type *>, Tp *>> entries; // the cached argument-type tuples, with their overloads..
+  };
+} // namespace ratio::core
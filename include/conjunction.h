@@ -1,18 +1,14 @@
 #pragma once
 #include "scope.h"
+#include "program.h"
 #include "rational.h"
 
-namespace riddle::ast
-{
-  class statement;
-} // namespace riddle::ast
-
 namespace ratio::core
 {
   class conjunction : public scope
   {
   public:
-    conjunction(scope &scp, context ctx, semitone::rational cst, const std::vector<std::unique_ptr<const riddle::ast::statement>> &stmnts);
+    conjunction(scope &scp, context ctx, semitone::rational cst, const program &body);
     conjunction(const conjunction &orig) = delete;
     virtual ~conjunction();
 
@@ -25,8 +21,8 @@ namespace ratio::core
     RATIOCORE_EXPORT void execute();
 
   private:
-    context ctx;                                                                  // the context within which the conjunction can be executed..
-    const semitone::rational cost;                                                // the cost for applying this conjunction..
-    const std::vector<std::unique_ptr<const riddle::ast::statement>> &statements; // the statements within the conjunction's body..
+    context ctx;                   // the context within which the conjunction can be executed..
+    const semitone::rational cost; // the cost for applying this conjunction..
+    const program &body;           // the compiled body of the conjunction..
   };
 } // namespace ratio::core
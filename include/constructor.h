@@ -1,31 +1,24 @@
 #pragma once
 #include "scope.h"
-
-namespace riddle
-{
-  class id_token;
-
-  namespace ast
-  {
-    class expression;
-    class statement;
-  } // namespace ast
-
-} // namespace riddle
+#include "program.h"
+#include "call_cache.h"
+#include "symbol.h"
 
 namespace ratio::core
 {
   class type;
-  class item;
-  using expr = std::shared_ptr<item>;
   class complex_item;
+  class expression;
+  class statement;
+  class constructor_declaration;
 
   class constructor : public scope
   {
     friend class type;
+    friend class constructor_declaration;
 
   public:
-    RATIOCORE_EXPORT constructor(type &tp, std::vector<field_ptr> args, const std::vector<riddle::id_token> &ins, const std::vector<std::vector<std::unique_ptr<const riddle::ast::expression>>> &ivs, const std::vector<std::unique_ptr<const riddle::ast::statement>> &stmnts);
+    RATIOCORE_EXPORT constructor(type &tp, std::vector<field_ptr> args, const std::vector<symbol> &ins, const std::vector<std::vector<const expression *>> &ivs, const std::vector<const statement *> &stmnts);
     constructor(const constructor &orig) = delete;
     RATIOCORE_EXPORT virtual ~constructor() = default;
 
@@ -35,9 +28,11 @@ namespace ratio::core
     void invoke(complex_item &itm, std::vector<expr> exprs);
 
   private:
-    std::vector<field *> args;                                                                 // the arguments of this constructor..
-    const std::vector<riddle::id_token> &init_names;                                           // the parameter names in the init-list..
-    const std::vector<std::vector<std::unique_ptr<const riddle::ast::expression>>> &init_vals; // for each parameter name in the init-list, its initializzation values..
-    const std::vector<std::unique_ptr<const riddle::ast::statement>> &statements;              // the statements within the constructor's body..
+    std::vector<field *> args;                                  // the arguments of this constructor..
+    const std::vector<symbol> *init_names;                      // the parameter names in the init-list..
+    const std::vector<std::vector<const expression *>> *init_vals; // for each parameter name in the init-list, its initializzation values..
+    const std::vector<const statement *> *statements;           // the statements within the constructor's body..
+    const program *body = nullptr;                              // the compiled body, once linked..
+    std::vector<call_cache<constructor>> init_caches;           // for each parameter name in the init-list, the constructors resolved for its initialization values..
   };
 } // namespace ratio::core
@@ -1,8 +1,16 @@
 #pragma once
 #include "scope.h"
 #include "env.h"
+#include "call_cache.h"
+#include "expr_table.h"
+#include "item_pool.h"
 #include "inf_rational.h"
+#include "lin.h"
 #include <unordered_set>
+#include <unordered_map>
+#include <map>
+#include <string_view>
+#include <chrono>
 #ifdef COMPUTE_NAMES
 #include <unordered_map>
 #endif
@@ -51,6 +59,31 @@ namespace ratio::core
 #define FIRE_SOLUTION_FOUND()
 #define FIRE_INCONSISTENT_PROBLEM()
 #endif
+
+  /**
+   * @brief The time spent in the different phases of the last `read` call.
+   *
+   */
+  struct read_timings
+  {
+    std::chrono::nanoseconds parsing{0};   // the time spent in lexing and parsing the riddle code..
+    std::chrono::nanoseconds declaring{0}; // the time spent in declaring the types and the predicates..
+    std::chrono::nanoseconds refining{0};  // the time spent in refining and linking the types, the predicates and the methods..
+    std::chrono::nanoseconds executing{0}; // the time spent in executing the statements..
+  };
+
+  /**
+   * @brief When the facts stated within the bodies of compilation units, rules and conjunctions are asserted.
+   *
+   */
+  enum class fact_flush_policy
+  {
+    eager,   // each fact is asserted as soon as it is stated..
+    per_body // the facts are buffered, and asserted together once the body has been executed..
+  };
+
+  class fact_batch;
+
   class core : public scope, public env
   {
     friend class formula_statement;
@@ -59,6 +92,14 @@ namespace ratio::core
     friend class typedef_declaration;
     friend class enum_declaration;
     friend class class_declaration;
+    friend class type;
+    friend class constructor;
+    friend class constructor_expression;
+    friend class function_expression;
+    friend class fact_batch;
+    friend class int_literal_expression;
+    friend class real_literal_expression;
+    friend class string_literal_expression;
 #ifdef BUILD_LISTENERS
     friend class core_listener;
 #endif
@@ -74,12 +115,151 @@ namespace ratio::core
      * @param script The riddle script to parse.
      */
     RATIOCORE_EXPORT virtual void read(const std::string &script);
+    /**
+     * @brief Parses the given riddle script.
+     *
+     * The script is read in place, without being copied, and must therefore remain valid during the call.
+     *
+     * @param script The riddle script to parse.
+     */
+    RATIOCORE_EXPORT virtual void read(std::string_view script);
+    void read(const char *script) { read(std::string_view(script)); } // parses the given riddle script, resolving the ambiguity between the above overloads for string literals..
     /**
      * @brief Parses the given riddle files.
      *
+     * The files are memory-mapped and read in place.
+     *
      * @param files The riddle files to parse.
      */
     RATIOCORE_EXPORT virtual void read(const std::vector<std::string> &files);
+    /**
+     * @brief Reloads a riddle file previously read, updating in place the bodies of its methods, predicates and constructors, adding its new declarations and executing its appended statements.
+     *
+     * The file is not reloaded, and the core is left untouched, if any of its previous declarations has been removed or has changed its parameters, fields or hierarchy, or if its previous statements are not a prefix of the new ones. Declarations and statements are compared regardless of their positions within the file. The replaced compilation unit is released unless the disjunctions it might have created still refer to its statements.
+     * Files read in streaming mode cannot be reloaded, since their statements are released once executed.
+     * The names of the reloaded code are interned in the symbol table shared by the whole process, which never shrinks: a long-running service reloading code with ever new names grows it without bound.
+     *
+     * @param file The riddle file to reload.
+     * @return true If the file has been reloaded.
+     * @return false If the file cannot be reloaded incrementally and a full rebuild is required.
+     * @throws std::invalid_argument Thrown if the file has not been previously read, or has been read in streaming mode.
+     */
+    RATIOCORE_EXPORT virtual bool reload(const std::string &file);
+
+    /**
+     * @brief Sets the number of threads used for parsing the riddle files.
+     *
+     * @param n The number of parsing threads (`0` means as many as the available hardware threads).
+     */
+    void set_parse_threads(const unsigned &n) noexcept { parse_threads = n; }
+    /**
+     * @brief Gets the number of threads used for parsing the riddle files.
+     *
+     * @return unsigned The number of parsing threads (`0` means as many as the available hardware threads).
+     */
+    unsigned get_parse_threads() const noexcept { return parse_threads; }
+    /**
+     * @brief Gets the time spent in the different phases of the last `read` call.
+     *
+     * @return const read_timings& The time spent in the different phases of the last `read` call.
+     */
+    const read_timings &get_read_timings() const noexcept { return timings; }
+    /**
+     * @brief Gets the statistics of the call-site caches of the method and constructor overloads.
+     *
+     * @return const call_cache_stats& The statistics of the call-site caches.
+     */
+    const call_cache_stats &get_call_cache_stats() const noexcept { return cc_stats; }
+    /**
+     * @brief Gets the statistics of the table through which structurally identical sums, comparisons, conjunctions and disjunctions share the same expression.
+     *
+     * The epoch of the statistics is incremented whenever the table is cleared through `clear_expr_table`, whereas the evictions of the oldest expressions, when the table is full, are not reported.
+     *
+     * @return const call_cache_stats& The statistics of the table of the expressions.
+     */
+    const call_cache_stats &get_expr_table_stats() const noexcept { return x_table.get_stats(); }
+    /**
+     * @brief Sets whether structurally identical sums, comparisons, conjunctions and disjunctions share the same expression.
+     *
+     * Shared expressions are reused regardless of the state of the solver, hence sharing should be enabled only by solvers whose expressions remain valid across backtracking, or which call `clear_expr_table` when backtracking.
+     *
+     * @param s `true` for sharing structurally identical expressions.
+     */
+    void set_expr_sharing(const bool &s) noexcept { expr_sharing = s; }
+    /**
+     * @brief Checks whether structurally identical sums, comparisons, conjunctions and disjunctions share the same expression.
+     *
+     * @return true If structurally identical expressions are shared.
+     * @return false If each call builds a new expression.
+     */
+    bool is_expr_sharing() const noexcept { return expr_sharing; }
+    /**
+     * @brief Sets when the facts stated within the bodies of compilation units, rules and conjunctions are asserted.
+     *
+     * Under the `per_body` policy, the backend receives the facts of a body through a single `assert_facts` call, and can propagate them at once.
+     *
+     * @param fp The flush policy of the facts.
+     */
+    void set_fact_flush_policy(fact_flush_policy fp) noexcept { flush_policy = fp; }
+    /**
+     * @brief Gets when the facts stated within the bodies of compilation units, rules and conjunctions are asserted.
+     *
+     * @return fact_flush_policy The flush policy of the facts.
+     */
+    fact_flush_policy get_fact_flush_policy() const noexcept { return flush_policy; }
+    /**
+     * @brief Creates a new object, typically an item, allocated from the pool of this core.
+     *
+     * The object must not outlive this core: destroying a core while any of its pooled objects (e.g., an item returned by `new_atoms` or kept by the caller) is still referred fails an assertion in debug builds.
+     *
+     * @tparam Tp The type of the object.
+     * @param args The arguments of the constructor of the object.
+     * @return std::shared_ptr<Tp> The new object.
+     */
+    template <typename Tp, typename... Args>
+    std::shared_ptr<Tp> new_pooled(Args &&...args) { return std::allocate_shared<Tp>(pool_allocator<Tp>(pool), std::forward<Args>(args)...); }
+    /**
+     * @brief Creates a new item, referred through the handles selected at build time.
+     *
+     * Items are allocated from the pool of this core, unless they are referred through intrusive handles, which delete them once unreferenced.
+     *
+     * @tparam Tp The type of the item.
+     * @param args The arguments of the constructor of the item.
+     * @return The handle to the new item.
+     */
+    template <typename Tp, typename... Args>
+#ifdef INTRUSIVE_EXPR
+    ref_ptr<Tp> new_item(Args &&...args) { return ref_ptr<Tp>(new Tp(std::forward<Args>(args)...)); }
+#else
+    std::shared_ptr<Tp> new_item(Args &&...args) { return new_pooled<Tp>(std::forward<Args>(args)...); }
+#endif
+    /**
+     * @brief Sets the directory in which the compilation units of the parsed riddle code are cached, in binary format, so as to skip lexing and parsing when reading the same code again.
+     *
+     * @param dir The cache directory (an empty string disables the cache).
+     */
+    void set_cache_dir(const std::string &dir) noexcept { cache_dir = dir; }
+    /**
+     * @brief Gets the directory in which the compilation units of the parsed riddle code are cached.
+     *
+     * @return const std::string& The cache directory (an empty string if the cache is disabled).
+     */
+    const std::string &get_cache_dir() const noexcept { return cache_dir; }
+    /**
+     * @brief Sets whether the riddle code is read in streaming mode.
+     *
+     * In streaming mode, the top-level statements are parsed, executed and released one at a time, so that the peak memory is bounded by the created items rather than by the size of the script. The type, method and predicate declarations, as well as the statements whose items refer to their bodies (i.e., disjunctions), are still retained. Files read in streaming mode cannot be reloaded.
+     *
+     * @param s `true` for reading the riddle code in streaming mode.
+     */
+    void set_streaming(const bool &s) noexcept { streaming = s; }
+    /**
+     * @brief Checks whether the riddle code is read in streaming mode.
+     *
+     * @return true If the riddle code is read in streaming mode.
+     * @return false If the riddle code is parsed in its entirety before being executed.
+     */
+    bool is_streaming() const noexcept { return streaming; }
 
     inline type &get_bool_type() const noexcept { return *bt; }
     inline type &get_int_type() const noexcept { return *it; }
@@ -95,10 +275,10 @@ namespace ratio::core
     virtual expr new_bool() noexcept { return nullptr; }
 
     /**
-     * @brief Creates a new boolean literal.
+     * @brief Returns the boolean literal having the given value, created once and shared by all its uses within this core.
      *
      * @param val The value of the literal.
-     * @return expr The new boolean literal.
+     * @return expr The boolean literal having the given value.
      */
     RATIOCORE_EXPORT expr new_bool(const bool &val) noexcept;
 
@@ -170,6 +350,16 @@ namespace ratio::core
      * @return expr The new enumerative variable.
      */
     virtual expr new_enum([[maybe_unused]] type &tp, [[maybe_unused]] const std::vector<expr> &allowed_vals) { return nullptr; }
+    /**
+     * @brief Creates a new enumerative variable whose initial domain is a shared snapshot of instances.
+     *
+     * Solvers can retain the snapshot instead of copying it. By default, the snapshot is copied into the other overload.
+     *
+     * @param tp The type of the enumerative variable.
+     * @param allowed_vals The snapshot of the initial domain of the enumerative variable.
+     * @return expr The new enumerative variable.
+     */
+    virtual expr new_enum(type &tp, const domain &allowed_vals) { return new_enum(tp, *allowed_vals); }
     /**
      * @brief Computes, if not already present, the `name` field of the enumerative variable `var`, introducing proper constraints for managing consistency.
      *
@@ -215,11 +405,86 @@ namespace ratio::core
      */
     virtual expr exct_one([[maybe_unused]] const std::vector<expr> &exprs) noexcept { return nullptr; }
 
-    virtual expr add([[maybe_unused]] const std::vector<expr> &exprs) noexcept { return nullptr; }
-    virtual expr sub([[maybe_unused]] const std::vector<expr> &exprs) noexcept { return nullptr; }
-    virtual expr mult([[maybe_unused]] const std::vector<expr> &exprs) noexcept { return nullptr; }
-    virtual expr div([[maybe_unused]] const std::vector<expr> &exprs) noexcept { return nullptr; }
-    virtual expr minus([[maybe_unused]] const expr &ex) noexcept { return nullptr; }
+    /**
+     * @brief Returns the negation of the given expression, folding the negation of a boolean constant into a boolean literal and invoking `negate` otherwise.
+     *
+     * @param var The expression to be negated.
+     * @return expr The negated expression.
+     */
+    RATIOCORE_EXPORT expr fold_negate(const expr &var) noexcept;
+    /**
+     * @brief Returns the conjunction of the given expressions, simplifying it before invoking `conj`.
+     *
+     * True and duplicate conjuncts are removed, and the conjunction is folded into the false literal if any conjunct is false or two conjuncts are complementary. The remaining conjuncts, if more than one, are passed to `conj`.
+     *
+     * @param exprs The expressions of the conjunction.
+     * @return expr The conjunction expression of the given expressions.
+     */
+    RATIOCORE_EXPORT expr fold_conj(const std::vector<expr> &exprs) noexcept;
+    /**
+     * @brief Returns the disjunction of the given expressions, simplifying it before invoking `disj`.
+     *
+     * False and duplicate disjuncts are removed, and the disjunction is folded into the true literal if any disjunct is true or two disjuncts are complementary. The remaining disjuncts, if more than one, are passed to `disj`.
+     *
+     * @param exprs The expressions of the disjunction.
+     * @return expr The disjunction expression of the given expressions.
+     */
+    RATIOCORE_EXPORT expr fold_disj(const std::vector<expr> &exprs) noexcept;
+    /**
+     * @brief Returns the exact-one of the given expressions, simplifying it before invoking `exct_one`.
+     *
+     * False operands are removed. A true operand, an operand appearing twice or two complementary operands force all the other operands to be false, hence the exact-one is turned into a conjunction of negations. The remaining operands, if more than one, are passed to `exct_one`.
+     *
+     * @param exprs The expressions of the exact-one.
+     * @return expr The exact-one expression of the given expressions.
+     */
+    RATIOCORE_EXPORT expr fold_exct_one(const std::vector<expr> &exprs) noexcept;
+
+    /**
+     * @brief Creates an expression which is the sum of the given arithmetic expressions.
+     *
+     * Since arithmetic items are linear expressions, the default implementation builds a single linear expression. This is the extension point of the sum: the core invokes it through `fold_add`, which folds the sums of constants beforehand.
+     *
+     * @param exprs The arithmetic expressions to be summed.
+     * @return expr The sum of the given expressions.
+     */
+    RATIOCORE_EXPORT virtual expr add(const std::vector<expr> &exprs) noexcept;
+    /**
+     * @brief Creates an expression which is the difference between the first of the given arithmetic expressions and the following ones.
+     *
+     * The default implementation builds a single linear expression. The core invokes it through `fold_sub`, which folds the differences of constants beforehand.
+     *
+     * @param exprs The arithmetic expressions to be subtracted.
+     * @return expr The difference of the given expressions.
+     */
+    RATIOCORE_EXPORT virtual expr sub(const std::vector<expr> &exprs) noexcept;
+    /**
+     * @brief Creates an expression which is the product of the given arithmetic expressions.
+     *
+     * The default implementation builds a single linear expression if at most one of the given expressions is not constant, and returns `nullptr` otherwise. The core invokes it through `fold_mult`, which folds the products of constants beforehand.
+     *
+     * @param exprs The arithmetic expressions to be multiplied.
+     * @return expr The product of the given expressions.
+     */
+    RATIOCORE_EXPORT virtual expr mult(const std::vector<expr> &exprs) noexcept;
+    /**
+     * @brief Creates an expression which is the quotient of the first of the given arithmetic expressions and the following ones.
+     *
+     * The default implementation builds a single linear expression if all the divisors are non-zero constants and, for integer expressions, the quotient is an integer constant, and returns `nullptr` otherwise. The core invokes it through `fold_div`, which folds the quotients of constants beforehand.
+     *
+     * @param exprs The arithmetic expressions to be divided.
+     * @return expr The quotient of the given expressions.
+     */
+    RATIOCORE_EXPORT virtual expr div(const std::vector<expr> &exprs) noexcept;
+    /**
+     * @brief Creates an expression which is the opposite of the given arithmetic expression.
+     *
+     * The default implementation builds a linear expression. The core invokes it through `fold_minus`, which folds the opposite of a constant beforehand.
+     *
+     * @param ex The arithmetic expression to be negated.
+     * @return expr The opposite of the given expression.
+     */
+    RATIOCORE_EXPORT virtual expr minus(const expr &ex) noexcept;
 
     virtual expr lt([[maybe_unused]] const expr &left, [[maybe_unused]] const expr &right) noexcept { return nullptr; }
     virtual expr leq([[maybe_unused]] const expr &left, [[maybe_unused]] const expr &right) noexcept { return nullptr; }
@@ -227,6 +492,104 @@ namespace ratio::core
     virtual expr geq([[maybe_unused]] const expr &left, [[maybe_unused]] const expr &right) noexcept { return nullptr; }
     virtual expr gt([[maybe_unused]] const expr &left, [[maybe_unused]] const expr &right) noexcept { return nullptr; }
 
+    /**
+     * @brief Returns the sum of the given arithmetic expressions, folding it into a literal if all the given expressions are constant and invoking `add` otherwise.
+     *
+     * Structurally identical sums share the same expression if expression sharing is enabled (see `set_expr_sharing`).
+     *
+     * @param exprs The arithmetic expressions to be summed.
+     * @return expr The sum of the given expressions.
+     */
+    RATIOCORE_EXPORT expr fold_add(const std::vector<expr> &exprs) noexcept;
+    /**
+     * @brief Returns the difference of the given arithmetic expressions, folding it into a literal if all the given expressions are constant and invoking `sub` otherwise.
+     *
+     * @param exprs The arithmetic expressions to be subtracted.
+     * @return expr The difference of the given expressions.
+     */
+    RATIOCORE_EXPORT expr fold_sub(const std::vector<expr> &exprs) noexcept;
+    /**
+     * @brief Returns the product of the given arithmetic expressions, folding it into a literal if all the given expressions are constant and invoking `mult` otherwise.
+     *
+     * @param exprs The arithmetic expressions to be multiplied.
+     * @return expr The product of the given expressions.
+     */
+    RATIOCORE_EXPORT expr fold_mult(const std::vector<expr> &exprs) noexcept;
+    /**
+     * @brief Returns the quotient of the given arithmetic expressions, folding it into a literal if all the given expressions are constant, the divisors are non-zero and, for integer expressions, the quotient is an integer, and invoking `div` otherwise.
+     *
+     * @param exprs The arithmetic expressions to be divided.
+     * @return expr The quotient of the given expressions.
+     */
+    RATIOCORE_EXPORT expr fold_div(const std::vector<expr> &exprs) noexcept;
+    /**
+     * @brief Returns the opposite of the given arithmetic expression, folding it into a literal if the expression is constant and invoking `minus` otherwise.
+     *
+     * @param ex The arithmetic expression to be negated.
+     * @return expr The opposite of the given expression.
+     */
+    RATIOCORE_EXPORT expr fold_minus(const expr &ex) noexcept;
+
+    /**
+     * @brief Returns a boolean expression which is true if the `left` arithmetic expression is less than the `right` one, folding the comparison of two constants into a boolean literal and invoking `lt` otherwise.
+     *
+     * Structurally identical comparisons share the same expression if expression sharing is enabled (see `set_expr_sharing`).
+     *
+     * @param left The left-hand side of the comparison.
+     * @param right The right-hand side of the comparison.
+     * @return expr The boolean expression of the comparison.
+     */
+    RATIOCORE_EXPORT expr fold_lt(const expr &left, const expr &right) noexcept;
+    /**
+     * @brief Returns a boolean expression which is true if the `left` arithmetic expression is less than or equal to the `right` one, folding the comparison of two constants into a boolean literal and invoking `leq` otherwise.
+     *
+     * @param left The left-hand side of the comparison.
+     * @param right The right-hand side of the comparison.
+     * @return expr The boolean expression of the comparison.
+     */
+    RATIOCORE_EXPORT expr fold_leq(const expr &left, const expr &right) noexcept;
+    /**
+     * @brief Returns a boolean expression which is true if the `left` expression is equal to the `right` one, folding the comparison of an expression with itself, as well as of two constants, into a boolean literal and invoking `eq` otherwise.
+     *
+     * @param left The left-hand side of the comparison.
+     * @param right The right-hand side of the comparison.
+     * @return expr The boolean expression of the comparison.
+     */
+    RATIOCORE_EXPORT expr fold_eq(const expr &left, const expr &right) noexcept;
+    /**
+     * @brief Returns a boolean expression which is true if the `left` arithmetic expression is greater than or equal to the `right` one, folding the comparison of two constants into a boolean literal and invoking `geq` otherwise.
+     *
+     * @param left The left-hand side of the comparison.
+     * @param right The right-hand side of the comparison.
+     * @return expr The boolean expression of the comparison.
+     */
+    RATIOCORE_EXPORT expr fold_geq(const expr &left, const expr &right) noexcept;
+    /**
+     * @brief Returns a boolean expression which is true if the `left` arithmetic expression is greater than the `right` one, folding the comparison of two constants into a boolean literal and invoking `gt` otherwise.
+     *
+     * @param left The left-hand side of the comparison.
+     * @param right The right-hand side of the comparison.
+     * @return expr The boolean expression of the comparison.
+     */
+    RATIOCORE_EXPORT expr fold_gt(const expr &left, const expr &right) noexcept;
+
+  protected:
+    /**
+     * @brief Creates an arithmetic expression of the given type having the given linear expression as value, or the corresponding literal if the linear expression is constant.
+     *
+     * @param tp The type of the arithmetic expression.
+     * @param l The value of the arithmetic expression.
+     * @return expr The arithmetic expression.
+     */
+    RATIOCORE_EXPORT expr new_arith(type &tp, const semitone::lin &l) noexcept;
+    /**
+     * @brief Clears the table through which structurally identical expressions are shared, releasing the indexed expressions and their operands.
+     *
+     * The shared expressions are reused regardless of the state of the solver, hence solvers whose expressions are undone by backtracking must call this when backtracking.
+     */
+    void clear_expr_table() noexcept { x_table.clear(); }
+
+  public:
     /**
      * @brief Checks whether the two expressions can be made equal.
      *
@@ -239,7 +602,8 @@ namespace ratio::core
 
     inline core &get_core() const override { return const_cast<core &>(*this); }
 
-    RATIOCORE_EXPORT expr get(const std::string &name) noexcept override;
+    using env::get;
+    RATIOCORE_EXPORT expr get(const symbol &name) noexcept override;
 
     /**
      * @brief Evaluates the given boolean expression.
@@ -277,6 +641,21 @@ namespace ratio::core
     virtual std::unordered_set<expr> enum_value([[maybe_unused]] const enum_item &x) const noexcept { return std::unordered_set<expr>(); }
     RATIOCORE_EXPORT bool is_constant([[maybe_unused]] const enum_item &x) const noexcept;
 
+    /**
+     * @brief Creates, in bulk, `n` new atoms of the given predicate whose arguments are given column by column.
+     *
+     * Each atom is instantiated as a formula statement would do: the arguments not given in any column, including those inherited from the super-predicates, are initialized with new instances (or existentials) of their types. The arguments are resolved and type-checked once per column rather than once per atom, and no riddle code is parsed.
+     *
+     * @param pred The predicate of the new atoms.
+     * @param n The number of new atoms.
+     * @param names The names of the given arguments (possibly including `tau`, for predicates declared within a type).
+     * @param columns The values of the given arguments, one column of `n` values for each name.
+     * @param is_fact `true` for creating facts, `false` for creating goals.
+     * @return std::vector<expr> The new atoms.
+     * @throws std::invalid_argument Thrown if the number of columns differs from the number of names or if a column has not `n` values.
+     */
+    RATIOCORE_EXPORT std::vector<expr> new_atoms(predicate &pred, const size_t &n, const std::vector<std::string> &names, const std::vector<std::vector<expr>> &columns, const bool &is_fact = true);
+
     /**
      * @brief Creates a new disjunction of conjunctions.
      *
@@ -284,10 +663,59 @@ namespace ratio::core
      */
     RATIOCORE_EXPORT virtual void new_disjunction(const std::vector<std::unique_ptr<conjunction>> conjs);
 
+  private:
+    /**
+     * @brief Returns the integer literal of the riddle code having the given value, created once and shared by all the literal nodes having that value.
+     *
+     * Only the literals of the riddle code are interned, so that the interned items are bounded by the size of the code, rather than by the values computed while executing it.
+     *
+     * @param val The value of the literal.
+     * @return expr The integer literal having the given value.
+     */
+    expr intern_int(const semitone::I &val) noexcept;
+    expr intern_real(const semitone::rational &val) noexcept;  // returns the real literal of the riddle code having the given value..
+    expr intern_string(const std::string &val) noexcept;      // returns the string literal of the riddle code having the given value..
+
+    template <typename Builder>
+    expr share(const expr_op op, std::vector<expr> operands, const bool commutative, Builder build) { return expr_sharing ? x_table.get(op, std::move(operands), commutative, build) : build(); } // builds the expression, sharing it if expression sharing is enabled..
+
+    /**
+     * @brief Creates `n` new atoms of the given predicate whose arguments, identified by their interned names, are given column by column.
+     *
+     * This is the instantiation shared by `new_atoms` and by the formula statements: each column is type-checked once, filtering the values of its enumerative expressions which cannot be assigned to the target type, and the remaining arguments, including the scope of the predicates declared within a type, are initialized with new instances (or existentials) of their types.
+     *
+     * @param pred The predicate of the new atoms.
+     * @param n The number of new atoms.
+     * @param names The interned names of the given arguments (possibly including `tau`).
+     * @param columns The values of the given arguments, one column of `n` values for each name.
+     * @param is_fact `true` for creating facts, `false` for creating goals.
+     * @return std::vector<expr> The new atoms.
+     */
+    std::vector<expr> instantiate_atoms(predicate &pred, const size_t &n, const std::vector<symbol> &names, const std::vector<std::vector<expr>> &columns, const bool &is_fact);
+
+    void read_script(std::string_view script);
+    std::unique_ptr<const riddle::ast::compilation_unit> parse(std::string_view content) const;
+    /**
+     * @brief Reads the given riddle code one top-level declaration or statement at a time.
+     *
+     * Consecutive declarations are declared and refined together, so that they can refer to each other, before executing the statements that follow them. Type and predicate declarations are parsed through the cache, if any, whereas the other chunks are parsed in place, so that a script with many statements does not fill the cache with an entry per statement.
+     *
+     * @param content The riddle code to read.
+     * @param ctx The context in which the statements are executed.
+     * @throws std::invalid_argument Thrown if a chunk cannot be parsed, prefixing the error with the line of the content at which the chunk starts.
+     */
+    void stream(std::string_view content, context &ctx);
+
   private:
     virtual void new_atom([[maybe_unused]] atom &atm, [[maybe_unused]] const bool &is_fact = true) {}
 
   public:
+    /**
+     * @brief States the given fact, which is either asserted right away or, under the `per_body` policy and within a `fact_batch`, buffered until the batch is flushed.
+     *
+     * @param fact The fact to be stated.
+     */
+    RATIOCORE_EXPORT void assert_fact(const expr &fact);
     virtual void assert_facts([[maybe_unused]] std::vector<expr> facts) {}
 
   protected:
@@ -297,12 +725,13 @@ namespace ratio::core
     RATIOCORE_EXPORT void new_predicate(predicate_ptr p) noexcept;
 
   public:
-    RATIOCORE_EXPORT const field &get_field(const std::string &name) const override;
-    RATIOCORE_EXPORT method &get_method(const std::string &name, const std::vector<const type *> &ts) const override;
+    RATIOCORE_EXPORT const field *find_field(const std::string &name) const noexcept override;
+    RATIOCORE_EXPORT method *find_method(const std::string &name, const std::vector<const type *> &ts) const noexcept override;
     const std::map<std::string, std::vector<method_ptr>> &get_methods() const noexcept override { return methods; }
-    RATIOCORE_EXPORT type &get_type(const std::string &name) const override;
+    using scope::get_type;
+    RATIOCORE_EXPORT type *find_type(const std::string &name) const noexcept override;
     const std::map<std::string, type_ptr> &get_types() const noexcept override { return types; }
-    RATIOCORE_EXPORT predicate &get_predicate(const std::string &name) const override;
+    RATIOCORE_EXPORT predicate *find_predicate(const std::string &name) const noexcept override;
     const std::map<std::string, predicate_ptr> &get_predicates() const noexcept override { return predicates; }
 
 #ifdef COMPUTE_NAMES
@@ -316,8 +745,34 @@ namespace ratio::core
 #endif
 
   private:
+    /**
+     * @brief Encodes the ancestors and the layouts of all the types of this core, so that subtype checks amount to bitset lookups and fields are found with a single probe.
+     *
+     * The numeric primitive types, although not inheriting from each other, are encoded as ancestors of each other, since `int` and `real` are assignable from `time` and vice versa.
+     */
+    void encode_hierarchy();
+
+  private:
+    item_pool pool; // the pool from which the items are allocated, declared first so as to outlive the other members..
     type *bt, *it, *rt, *tt, *st;
     std::vector<std::unique_ptr<const riddle::ast::compilation_unit>> cus; // the compilation units..
+    unsigned parse_threads = 0;                                            // the number of threads used for parsing the riddle files (`0` means as many as the available hardware threads)..
+    read_timings timings;                                                  // the time spent in the different phases of the last `read` call..
+    call_cache_stats cc_stats;                                             // the statistics of the call-site caches..
+    expr true_itm, false_itm;                                              // the boolean literals..
+    std::map<semitone::I, expr> int_itms;                                  // the integer literals of the riddle code, indexed by their values..
+    std::map<semitone::rational, expr> real_itms;                          // the real literals of the riddle code, indexed by their values..
+    std::unordered_map<std::string, expr> string_itms;                     // the string literals of the riddle code, indexed by their values..
+    expr_table x_table;                                                    // the non-literal expressions, indexed by their operator and operands, so that they are not built twice..
+    bool expr_sharing = false;                                             // whether structurally identical expressions are shared through `x_table`..
+    fact_flush_policy flush_policy = fact_flush_policy::eager;             // when the stated facts are asserted..
+    std::vector<expr> pending_facts;                                       // the facts stated within the open batches and not asserted yet..
+    size_t n_batches = 0;                                                  // the number of open fact batches..
+    size_t n_types = 0;                                                    // the number of types created within this core, used for assigning them dense indexes..
+    bool hierarchy_changed = true;                                         // whether a type, a supertype or a field has been added since the types have been encoded..
+    std::string cache_dir;                                                 // the directory in which the compilation units are cached (empty if the cache is disabled)..
+    std::map<std::string, const riddle::ast::compilation_unit *> file_cus; // the most recent compilation unit of each read file..
+    bool streaming = false;                                                // whether the riddle code is read one top-level declaration or statement at a time..
 
     std::map<std::string, std::vector<method_ptr>> methods; // the methods, indexed by their name, defined within this core..
     std::map<std::string, type_ptr> types;                  // the inner types, indexed by their name, defined within this core..
@@ -329,7 +784,7 @@ namespace ratio::core
 
   protected:
     RATIOCORE_EXPORT void fire_log(const std::string msg) const noexcept;
-    RATIOCORE_EXPORT void fire_read(const std::string &script) const noexcept;
+    RATIOCORE_EXPORT void fire_read(std::string_view script) const noexcept;
     RATIOCORE_EXPORT void fire_read(const std::vector<std::string> &files) const noexcept;
     RATIOCORE_EXPORT void fire_state_changed() const noexcept;
     RATIOCORE_EXPORT void fire_started_solving() const noexcept;
@@ -338,6 +793,32 @@ namespace ratio::core
 #endif
   };
 
+  /**
+   * @brief A batch of the facts stated while executing a body, buffered under the `per_body` policy and asserted together when the batch is flushed.
+   *
+   * Batches can be nested, in which case only flushing the outermost batch asserts the buffered facts, so that they reach the backend in the order in which they have been stated. Flushing a nested batch hands its facts over to the enclosing batch.
+   * The facts still buffered when a batch is destroyed without having been flushed (e.g., because an inconsistency has been found) are discarded, including those handed over by its nested batches.
+   */
+  class fact_batch
+  {
+  public:
+    RATIOCORE_EXPORT fact_batch(core &cr) noexcept;
+    fact_batch(const fact_batch &orig) = delete;
+    RATIOCORE_EXPORT ~fact_batch();
+
+    /**
+     * @brief Asserts the buffered facts if this is the outermost batch, otherwise hands the facts of this batch over to the enclosing batch.
+     *
+     */
+    RATIOCORE_EXPORT void flush();
+
+  private:
+    core &cr;
+    const size_t start;   // the number of buffered facts when this batch has been opened..
+    const size_t depth;   // the number of open batches, including this one, when this batch has been opened..
+    bool flushed = false; // whether this batch has been flushed..
+  };
+
   class inconsistency_exception : public std::exception
   {
     const char *what() const noexcept override { return "an inconsistency has been found.."; }
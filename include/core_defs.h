@@ -1,6 +1,10 @@
 #pragma once
 #include "ratiocore_export.h"
 #include <memory>
+#include <vector>
+#ifdef INTRUSIVE_EXPR
+#include "ref_ptr.h"
+#endif
 
 #define THIS_KW "this"
 #define RETURN_KW "return"
@@ -15,6 +19,9 @@ namespace ratio::core
   using constructor_ptr = std::unique_ptr<constructor>;
   class field;
   using field_ptr = std::unique_ptr<field>;
+  template <typename Tp>
+  class symbol_map;
+  using slot_layout = symbol_map<const field *>; // the layout of the instances of a type, in which the slot of each field is its position..
   class predicate;
   using predicate_ptr = std::unique_ptr<predicate>;
   class method;
@@ -22,5 +29,10 @@ namespace ratio::core
   class env;
   using context = std::shared_ptr<env>;
   class item;
+#ifdef INTRUSIVE_EXPR
+  using expr = ref_ptr<item>;
+#else
   using expr = std::shared_ptr<item>;
+#endif
+  using domain = std::shared_ptr<const std::vector<expr>>; // an immutable snapshot of the instances of a type, shared among the variables having them as initial domain..
 } // namespace ratio::core
@@ -1,6 +1,6 @@
 #pragma once
 #include "core_defs.h"
-#include <map>
+#include "symbol_map.h"
 #include <string>
 
 namespace ratio::core
@@ -12,6 +12,7 @@ namespace ratio::core
 
   class env
   {
+    friend class frame;
     friend class core;
     friend class predicate;
     friend class constructor;
@@ -33,13 +34,79 @@ namespace ratio::core
      * @param name The name of the variable.
      * @return expr The expression having the given name.
      */
-    RATIOCORE_EXPORT virtual expr get(const std::string &name);
+    expr get(const std::string &name)
+    { // a name which has never been interned is not the name of any variable..
+        const auto sym = symbol::find(name);
+        return sym ? get(*sym) : nullptr;
+    }
+    /**
+     * @brief Get the expression having the given interned name, searching in the enclosing environments if not found in the current environment.
+     *
+     * @param name The interned name of the variable.
+     * @return expr The expression having the given interned name.
+     */
+    RATIOCORE_EXPORT virtual expr get(const symbol &name);
+    /**
+     * @brief Sets the variable having the given interned name in the current environment, unless the variable has already been set.
+     *
+     * @param name The interned name of the variable.
+     * @param xpr The value of the variable.
+     */
+    RATIOCORE_EXPORT virtual void set(const symbol &name, expr xpr);
 
   private:
     env &e;
     context ctx;
 
   protected:
-    std::map<std::string, expr> vars;
+    symbol_map<expr> vars;
+  };
+
+  /**
+   * @brief A call frame, living on the stack of an invocation (e.g., of a constructor or of a rule), whose first variables are stored inline.
+   *
+   * The frame is referred through a non-owning context, which has to be promoted, through `capture`, to a heap environment whenever it might outlive the invocation (e.g., when captured by a conjunction).
+   */
+  class frame final : public env
+  {
+  public:
+    static constexpr size_t inline_capacity = 4;
+
+    frame(env &e) : env(e) {}
+    frame(const frame &orig) = delete;
+
+    /**
+     * @brief Get a non-owning context referring to this frame, valid as long as this frame is alive.
+     *
+     * @return context A non-owning context referring to this frame.
+     */
+    context get_context() noexcept { return context(context(), this); }
+
+    using env::get;
+    RATIOCORE_EXPORT expr get(const symbol &name) override;
+    RATIOCORE_EXPORT void set(const symbol &name, expr xpr) override;
+
+    /**
+     * @brief Creates a heap environment having the same enclosing environment and the same variables as this frame.
+     *
+     * The environment is allocated from the pool of the core enclosing this frame, hence it must not outlive the core.
+     *
+     * @return context The heap environment.
+     */
+    RATIOCORE_EXPORT context promote() const;
+
+  private:
+    uint32_t ids[inline_capacity];              // the dense integers of the names of the inline variables..
+    const std::string *names[inline_capacity]; // the interned names of the inline variables, so that promoting them requires no lookup..
+    expr vals[inline_capacity];                 // the values of the inline variables..
+    size_t n_inline = 0;                        // the number of inline variables..
   };
+
+  /**
+   * @brief Returns a context which can outlive the current invocation, promoting the referred frame to a heap environment if needed.
+   *
+   * @param ctx The context to capture.
+   * @return context Either the given context, if owning its environment, or a heap copy of the referred frame.
+   */
+  RATIOCORE_EXPORT context capture(const context &ctx);
 } // namespace ratio::core
@@ -0,0 +1,120 @@
+#pragma once
+#include "call_cache.h"
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+
+namespace ratio::core
+{
+  /**
+   * @brief The operators whose expressions are shared among structurally identical calls.
+   *
+   */
+  enum class expr_op : uint8_t
+  {
+    add,
+    lt,
+    leq,
+    eq,
+    geq,
+    gt,
+    conj,
+    disj
+  };
+
+  /**
+   * @brief A table of the expressions built by a core, indexed by their operator and by the identity of their operands, so that structurally identical calls return the same expression.
+   *
+   * The operands of the indexed expressions are retained, so that their addresses cannot be reused by other items. To avoid pinning them forever, the table holds up to `max_entries` expressions, evicting the oldest one when full.
+   *
+   * The indexed expressions are reused regardless of the state of the solver, hence they must remain valid across backtracking. A solver whose expressions are undone by backtracking (e.g., reified constraints added above the root level) must `clear` the table when backtracking.
+   */
+  class expr_table
+  {
+  public:
+    static constexpr size_t default_max_entries = 1 << 16;
+
+    explicit expr_table(const size_t &max_entries = default_max_entries) : max_entries(max_entries) {}
+    /**
+     * @brief Returns the expression applying the given operator to the given operands, building and indexing it if not indexed yet.
+     *
+     * Expressions which could not be built (i.e., `nullptr`) are not indexed.
+     *
+     * @param op The operator of the expression.
+     * @param operands The operands of the expression.
+     * @param commutative Whether the order of the operands is irrelevant.
+     * @param build The function building the expression.
+     * @return expr The expression applying the given operator to the given operands.
+     */
+    template <typename Builder>
+    expr get(const expr_op op, std::vector<expr> operands, const bool commutative, Builder build)
+    {
+      if (commutative)
+        std::sort(operands.begin(), operands.end(), [](const expr &lhs, const expr &rhs)
+                  { return std::less<const item *>()(lhs.get(), rhs.get()); });
+
+      key k{op, std::move(operands)};
+      if (const auto it = table.find(k); it != table.cend())
+      {
+        stats.hits++;
+        return it->second;
+      }
+
+      stats.misses++;
+      expr x = build();
+      if (x)
+      {
+        if (table.size() == max_entries)
+        { // we evict the oldest expression..
+          table.erase(table.find(*order.front()));
+          order.pop_front();
+        }
+        order.push_back(&table.emplace(std::move(k), x).first->first);
+      }
+      return x;
+    }
+
+    /**
+     * @brief Removes all the indexed expressions, releasing their operands, and increments the epoch of the statistics.
+     *
+     */
+    void clear() noexcept
+    {
+      order.clear();
+      table.clear();
+      stats.epoch++;
+    }
+
+    const call_cache_stats &get_stats() const noexcept { return stats; }
+    size_t size() const noexcept { return table.size(); }
+
+  private:
+    struct key
+    {
+      expr_op op;
+      std::vector<expr> operands;
+
+      bool operator==(const key &other) const noexcept { return op == other.op && operands == other.operands; }
+    };
+
+    struct key_hash
+    {
+      size_t operator()(const key &k) const noexcept
+      {
+        size_t h = static_cast<size_t>(k.op);
+        for (const auto &o : k.operands)
+          h ^= std::hash<const item *>()(o.get()) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+      }
+    };
+
+  private:
+    size_t max_entries;                            // the maximum number of indexed expressions..
+    std::unordered_map<key, expr, key_hash> table; // the expressions, indexed by their operator and their operands..
+    std::deque<const key *> order;                 // the keys of the indexed expressions, from the oldest to the newest..
+    call_cache_stats stats;                        // the statistics of this table, whose epoch is incremented whenever the table is cleared..
+  };
+} // namespace ratio::core
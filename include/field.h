@@ -1,27 +1,33 @@
 #pragma once
 #include "ratiocore_export.h"
+#include "symbol.h"
 #include "riddle_parser.h"
 
 namespace ratio::core
 {
   class type;
+  class expression;
 
   class field final
   {
+    friend class field_declaration;
+
   public:
-    field(type &tp, const std::string &name, const std::unique_ptr<const riddle::ast::expression> &e = nullptr, bool synthetic = false) : tp(tp), name(name), xpr(std::move(e)), synthetic(synthetic) {}
+    field(type &tp, const std::string &name, const expression *e = nullptr, bool synthetic = false) : tp(tp), name(name), sym(name), xpr(e), synthetic(synthetic) {}
     field(const field &orig) = delete;
 
-    inline type &get_type() const { return tp; }                                                        // returns the type of the field..
-    inline const std::string &get_name() const { return name; }                                         // returns the name of the field..
-    inline const std::unique_ptr<const riddle::ast::expression> &get_expression() const { return xpr; } // returns, if any, the initialization expression..
-    inline bool is_synthetic() const { return synthetic; }                                              // returns whether the field is synthetic or not..
+    inline type &get_type() const { return tp; }                    // returns the type of the field..
+    inline const std::string &get_name() const { return name; }     // returns the name of the field..
+    inline const symbol &get_symbol() const { return sym; }         // returns the interned name of the field..
+    inline const expression *get_expression() const { return xpr; } // returns, if any, the initialization expression..
+    inline bool is_synthetic() const { return synthetic; }          // returns whether the field is synthetic or not..
 
   private:
-    type &tp;                                                  // the type of the field..
-    const std::string name;                                    // the name of the field..
-    const std::unique_ptr<const riddle::ast::expression> &xpr; // the initialization expression..
-    const bool synthetic;                                      // the field is synthetic (a synthetic field is a field which is not created by the user, e.g. 'this')..
+    type &tp;               // the type of the field..
+    const std::string name; // the name of the field..
+    const symbol sym;       // the interned name of the field..
+    const expression *xpr;  // the initialization expression, if any, rebound when its declaration is reloaded..
+    const bool synthetic;   // the field is synthetic (a synthetic field is a field which is not created by the user, e.g. 'this')..
   };
 
   using field_ptr = std::unique_ptr<field>;
@@ -4,12 +4,18 @@
 #include "lin.h"
 #include "var_value.h"
 #include <map>
+#include <vector>
+#include <utility>
 
 namespace ratio::core
 {
   class type;
 
+#ifdef INTRUSIVE_EXPR
+  class item : public semitone::var_value, public ref_counted
+#else
   class item : public semitone::var_value
+#endif
   {
   public:
     item(type &tp);
@@ -22,6 +28,20 @@ namespace ratio::core
     type &tp;
   };
 
+  /**
+   * @brief Gets a handle to an item owned elsewhere, such as the item on which a constructor or a rule is invoked.
+   *
+   * Intrusive handles share the count stored within the item, while shared pointers are aliased to an empty owner, so that the item is not deleted twice.
+   *
+   * @param itm The item owned elsewhere.
+   * @return expr A handle to the item.
+   */
+#ifdef INTRUSIVE_EXPR
+  inline expr borrow(item &itm) noexcept { return expr(&itm); }
+#else
+  inline expr borrow(item &itm) noexcept { return expr(expr(), &itm); }
+#endif
+
   class bool_item final : public item
   {
   public:
@@ -40,7 +60,7 @@ namespace ratio::core
     RATIOCORE_EXPORT arith_item(type &t, const semitone::lin &l);
     arith_item(const arith_item &that) = delete;
 
-    inline semitone::lin get_value() const { return l; }
+    inline const semitone::lin &get_value() const noexcept { return l; }
 
   private:
     const semitone::lin l;
@@ -58,6 +78,11 @@ namespace ratio::core
     std::string l;
   };
 
+  /**
+   * @brief An item having fields.
+   *
+   * The values of the fields are stored in slots, according to the layout of the type of the item at the time of its creation, while any other variable is stored by name.
+   */
   class complex_item : public item, public env
   {
   public:
@@ -65,7 +90,35 @@ namespace ratio::core
     complex_item(const complex_item &orig) = delete;
     RATIOCORE_EXPORT virtual ~complex_item() = default;
 
-    RATIOCORE_EXPORT expr get(const std::string &name) noexcept override;
+    using env::get;
+    RATIOCORE_EXPORT expr get(const symbol &name) noexcept override;
+
+    /**
+     * @brief Find the value of the variable having the given interned name, without searching in the enclosing environments.
+     *
+     * @param name The interned name of the variable.
+     * @return expr The value of the variable, or `nullptr` if the variable has not been set.
+     */
+    RATIOCORE_EXPORT expr find_var(const symbol &name) const noexcept;
+    /**
+     * @brief Set the value of the variable having the given interned name, unless the variable has already been set.
+     *
+     * @param name The interned name of the variable.
+     * @param xpr The value of the variable.
+     * @return true If the variable has been set.
+     * @return false If the variable had already been set.
+     */
+    RATIOCORE_EXPORT bool set_var(const symbol &name, expr xpr) noexcept;
+    /**
+     * @brief Get the variables which have been set, along with their interned names, the fields coming first, in slot order.
+     *
+     * @return std::vector<std::pair<symbol, expr>> The variables which have been set, along with their interned names.
+     */
+    RATIOCORE_EXPORT std::vector<std::pair<symbol, expr>> get_vars() const noexcept;
+
+  private:
+    const slot_layout &layout; // the layout of this item..
+    std::vector<expr> slots;   // the values of the fields of this item, indexed by their slots..
   };
 
   class enum_item final : public complex_item
@@ -74,7 +127,8 @@ namespace ratio::core
     RATIOCORE_EXPORT enum_item(type &t, semitone::var ev);
     enum_item(const enum_item &that) = delete;
 
-    RATIOCORE_EXPORT expr get(const std::string &name) noexcept override;
+    using complex_item::get;
+    RATIOCORE_EXPORT expr get(const symbol &name) noexcept override;
 
     inline semitone::var get_var() const { return ev; }
 
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "ratiocore_export.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ratio::core
+{
+  /**
+   * @brief A pool of memory blocks from which a core allocates its items and its promoted contexts.
+   *
+   * Only the items referred through `std::shared_ptr` handles are pooled: under `INTRUSIVE_EXPR` the items are deleted by their handles, hence they are allocated from the heap. Conjunctions are not pooled either, since they are handed over to `core::new_disjunction` as `std::unique_ptr`s.
+   * Blocks are rounded up to multiples of `granularity` bytes and carved out of chunks of `chunk_size` bytes, with a free list for each block size, so that allocating and deallocating a block amounts to popping and pushing a free list.
+   * Blocks larger than `max_block_size` bytes are allocated from the heap.
+   * Chunks are released all at once when the pool is destroyed, hence the pool must outlive the objects allocated from it. The pool counts its allocated blocks, and destroying it while any of them is still allocated fails an assertion in debug builds.
+   */
+  class item_pool
+  {
+  public:
+    static constexpr size_t granularity = alignof(std::max_align_t);
+    static constexpr size_t max_block_size = 512;
+    static constexpr size_t chunk_size = 64 * 1024;
+
+    item_pool() = default;
+    item_pool(const item_pool &orig) = delete;
+    RATIOCORE_EXPORT ~item_pool();
+
+    /**
+     * @brief Allocates a block of the given size.
+     *
+     * @param size The size, in bytes, of the block.
+     * @return void* The allocated block, aligned as `std::max_align_t`.
+     */
+    RATIOCORE_EXPORT void *allocate(size_t size);
+    /**
+     * @brief Deallocates the given block, previously allocated with the given size.
+     *
+     * @param p The block to deallocate.
+     * @param size The size, in bytes, with which the block has been allocated.
+     */
+    RATIOCORE_EXPORT void deallocate(void *p, size_t size) noexcept;
+
+    size_t get_chunks() const noexcept { return chunks.size(); } // returns the number of chunks allocated so far..
+    size_t get_blocks() const noexcept { return n_blocks; }      // returns the number of blocks currently allocated, including those allocated from the heap..
+
+  private:
+    struct free_block
+    {
+      free_block *next;
+    };
+
+    static constexpr size_t n_classes = max_block_size / granularity;
+
+    std::vector<std::unique_ptr<char[]>> chunks; // the chunks the pooled blocks are carved out of..
+    char *next_block = nullptr;                  // the beginning of the uncarved part of the last chunk..
+    size_t remaining = 0;                        // the size of the uncarved part of the last chunk..
+    free_block *free_lists[n_classes] = {};      // the deallocated blocks, one list for each block size..
+    size_t n_blocks = 0;                         // the number of blocks currently allocated..
+  };
+
+  /**
+   * @brief An allocator drawing from an item pool, intended for `std::allocate_shared`.
+   *
+   * The allocator refers to its pool without owning it, so that copying the allocator into each control block costs neither an atomic reference count nor the space of a shared pointer. The pool must therefore outlive the objects allocated through the allocator, which is checked, in debug builds, when the pool is destroyed.
+   */
+  template <typename Tp>
+  class pool_allocator
+  {
+    template <typename Up>
+    friend class pool_allocator;
+
+  public:
+    using value_type = Tp;
+
+    pool_allocator(item_pool &pool) noexcept : pool(&pool) {}
+    template <typename Up>
+    pool_allocator(const pool_allocator<Up> &other) noexcept : pool(other.pool) {}
+
+    Tp *allocate(size_t n)
+    {
+      static_assert(alignof(Tp) <= item_pool::granularity, "over-aligned types cannot be pooled");
+      return static_cast<Tp *>(pool->allocate(n * sizeof(Tp)));
+    }
+    void deallocate(Tp *p, size_t n) noexcept { pool->deallocate(p, n * sizeof(Tp)); }
+
+    template <typename Up>
+    friend bool operator==(const pool_allocator &lhs, const pool_allocator<Up> &rhs) noexcept { return lhs.pool == rhs.pool; }
+    template <typename Up>
+    friend bool operator!=(const pool_allocator &lhs, const pool_allocator<Up> &rhs) noexcept { return lhs.pool != rhs.pool; }
+
+  private:
+    item_pool *pool; // the pool the objects are allocated from..
+  };
+} // namespace ratio::core
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ratiocore_export.h"
+#include <string>
+#include <string_view>
+
+namespace ratio::core
+{
+  /**
+   * @brief A read-only memory mapping of a file.
+   *
+   */
+  class mapped_file
+  {
+  public:
+    /**
+     * @brief Maps the file at the given path into memory.
+     *
+     * @param path The path of the file to map.
+     * @throws std::invalid_argument Thrown if the file cannot be opened or mapped.
+     */
+    RATIOCORE_EXPORT mapped_file(const std::string &path);
+    mapped_file(const mapped_file &orig) = delete;
+    RATIOCORE_EXPORT ~mapped_file();
+
+    /**
+     * @brief Get the content of the mapped file.
+     *
+     * @return std::string_view A view on the content of the mapped file, valid as long as this object is alive.
+     */
+    inline std::string_view get_content() const noexcept { return std::string_view(data, size); }
+
+  private:
+    const char *data = nullptr; // the mapped content of the file..
+    size_t size = 0;            // the size of the file..
+#ifdef _WIN32
+    void *file = nullptr;    // the handle of the file..
+    void *mapping = nullptr; // the handle of the mapping..
+#endif
+  };
+} // namespace ratio::core
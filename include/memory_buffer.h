@@ -0,0 +1,49 @@
+#pragma once
+
+#include <streambuf>
+#include <string_view>
+
+namespace ratio::core
+{
+  /**
+   * @brief A read-only stream buffer over a contiguous region of memory.
+   *
+   * The characters are read directly from the given memory, without copying them into any intermediate buffer. The memory must outlive the buffer.
+   */
+  class memory_buffer : public std::streambuf
+  {
+  public:
+    memory_buffer(std::string_view data) noexcept
+    {
+      char *begin = const_cast<char *>(data.data()); // the buffer is never written..
+      setg(begin, begin, begin + data.size());
+    }
+    memory_buffer(const memory_buffer &orig) = delete;
+
+  protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in) override
+    {
+      if (!(which & std::ios_base::in))
+        return pos_type(off_type(-1));
+
+      off_type pos;
+      switch (dir)
+      {
+      case std::ios_base::beg:
+        pos = off;
+        break;
+      case std::ios_base::cur:
+        pos = (gptr() - eback()) + off;
+        break;
+      default:
+        pos = (egptr() - eback()) + off;
+        break;
+      }
+      if (pos < 0 || pos > egptr() - eback())
+        return pos_type(off_type(-1));
+      setg(eback(), eback() + pos, egptr());
+      return pos_type(pos);
+    }
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in) override { return seekoff(off_type(pos), std::ios_base::beg, which); }
+  };
+} // namespace ratio::core
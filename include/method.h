@@ -1,18 +1,18 @@
 #pragma once
 #include "scope.h"
+#include "program.h"
 
-namespace riddle::ast
+namespace ratio::core
 {
-  class expression;
   class statement;
-} // namespace riddle::ast
+  class method_declaration;
 
-namespace ratio::core
-{
   class method : public scope
   {
+    friend class method_declaration;
+
   public:
-    RATIOCORE_EXPORT method(scope &scp, type *return_type, const std::string &name, std::vector<field_ptr> args, const std::vector<std::unique_ptr<const riddle::ast::statement>> &stmnts);
+    RATIOCORE_EXPORT method(scope &scp, type *return_type, const std::string &name, std::vector<field_ptr> args, const std::vector<const statement *> &stmnts);
     method(const method &orig) = delete;
     RATIOCORE_EXPORT virtual ~method();
 
@@ -23,9 +23,10 @@ namespace ratio::core
     expr invoke(context &ctx, std::vector<expr> exprs);
 
   private:
-    type *return_type;                                                            // the return type of this method (can be nullptr)..
-    const std::string name;                                                       // the name of this method..
-    std::vector<field *> args;                                                    // the arguments of this method..
-    const std::vector<std::unique_ptr<const riddle::ast::statement>> &statements; // the statements within the method's body..
+    type *return_type;                               // the return type of this method (can be nullptr)..
+    const std::string name;                          // the name of this method..
+    std::vector<field *> args;                       // the arguments of this method..
+    const std::vector<const statement *> *statements; // the statements within the method's body..
+    const program *body = nullptr;                   // the compiled body, once linked..
   };
 } // namespace ratio::core
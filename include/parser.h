@@ -1,10 +1,52 @@
 #pragma once
 
 #include "env.h"
+#include "program.h"
+#include "call_cache.h"
 #include "riddle_parser.h"
 
 namespace ratio::core
 {
+  class ast_writer;
+
+  /**
+   * @brief Returns the core-side view of a node built by the core parser, or `nullptr` if the node is absent.
+   *
+   * Since nodes inherit both from a riddle node and from a core node, the cross-cast is performed once, when the enclosing node is built, so that no cast is required when executing.
+   */
+  template <typename Tp, typename Fp>
+  const Tp *to_core(const std::unique_ptr<const Fp> &n) { return n ? &dynamic_cast<const Tp &>(*n) : nullptr; }
+  template <typename Tp, typename Fp>
+  std::vector<const Tp *> to_core(const std::vector<std::unique_ptr<const Fp>> &ns)
+  {
+    std::vector<const Tp *> c_ns;
+    c_ns.reserve(ns.size());
+    for (const auto &n : ns)
+      c_ns.push_back(to_core<Tp>(n));
+    return c_ns;
+  }
+  template <typename Tp, typename Fp>
+  std::vector<std::vector<const Tp *>> to_core(const std::vector<std::vector<std::unique_ptr<const Fp>>> &nss)
+  {
+    std::vector<std::vector<const Tp *>> c_nss;
+    c_nss.reserve(nss.size());
+    for (const auto &ns : nss)
+      c_nss.push_back(to_core<Tp>(ns));
+    return c_nss;
+  }
+
+  /**
+   * @brief Interns the given identifiers, once, when the enclosing node is built.
+   */
+  inline std::vector<symbol> to_symbols(const std::vector<riddle::id_token> &ids)
+  {
+    std::vector<symbol> syms;
+    syms.reserve(ids.size());
+    for (const auto &id : ids)
+      syms.emplace_back(id.id);
+    return syms;
+  }
+
   class expression : public riddle::ast::expression
   {
   public:
@@ -13,7 +55,39 @@ namespace ratio::core
     virtual ~expression() = default;
 
     virtual expr evaluate(scope &scp, context &ctx) const = 0;
-  };
+    virtual void write(ast_writer &w) const = 0;
+    /**
+     * @brief Resolves, once and for all, the static references to types and predicates of this expression, and of its sub-expressions, within the scope in which it is declared.
+     *
+     * @param scp The scope in which this expression is declared.
+     */
+    virtual void link(scope &) const {}
+    /**
+     * @brief Appends to the given program the instructions evaluating this expression.
+     *
+     * @param p The program to append the instructions to.
+     * @return uint32_t The register holding the value of this expression.
+     */
+    virtual uint32_t compile(program &p) const = 0;
+  };
+
+  /**
+   * @brief Returns the core-side operands of an associative expression of kind `Tp`, replacing the operands which are themselves of kind `Tp` with their operands.
+   *
+   * Since the operands are built before the enclosing node, their operands are already flattened.
+   */
+  template <typename Tp, typename Fp>
+  std::vector<const expression *> flatten(const std::vector<std::unique_ptr<const Fp>> &ns)
+  {
+    std::vector<const expression *> c_ns;
+    c_ns.reserve(ns.size());
+    for (const auto &n : ns)
+      if (const Tp *op = dynamic_cast<const Tp *>(n.get()))
+        c_ns.insert(c_ns.cend(), op->get_operands().cbegin(), op->get_operands().cend());
+      else
+        c_ns.push_back(to_core<expression>(n));
+    return c_ns;
+  }
 
   class bool_literal_expression final : public riddle::ast::bool_literal_expression, public expression
   {
@@ -22,6 +96,11 @@ namespace ratio::core
     bool_literal_expression(const bool_literal_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    mutable expr c_val; // the literal, cached at its first evaluation..
   };
 
   class int_literal_expression final : public riddle::ast::int_literal_expression, public expression
@@ -31,6 +110,11 @@ namespace ratio::core
     int_literal_expression(const int_literal_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    mutable expr c_val; // the literal, cached at its first evaluation..
   };
 
   class real_literal_expression final : public riddle::ast::real_literal_expression, public expression
@@ -40,6 +124,11 @@ namespace ratio::core
     real_literal_expression(const real_literal_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    mutable expr c_val; // the literal, cached at its first evaluation..
   };
 
   class string_literal_expression final : public riddle::ast::string_literal_expression, public expression
@@ -49,195 +138,335 @@ namespace ratio::core
     string_literal_expression(const string_literal_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    mutable expr c_val; // the literal, cached at its first evaluation..
   };
 
   class cast_expression final : public riddle::ast::cast_expression, public expression
   {
   public:
-    cast_expression(const std::vector<riddle::id_token> &tp, std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::cast_expression(tp, std::move(e)) {}
+    cast_expression(const std::vector<riddle::id_token> &tp, std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::cast_expression(tp, std::move(e)), c_xpr(to_core<ratio::core::expression>(xpr)) {}
     cast_expression(const cast_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_xpr; // the core-side sub-expression..
   };
 
   class plus_expression final : public riddle::ast::plus_expression, public expression
   {
   public:
-    plus_expression(std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::plus_expression(std::move(e)) {}
+    plus_expression(std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::plus_expression(std::move(e)), c_xpr(to_core<ratio::core::expression>(xpr)) {}
     plus_expression(const plus_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_xpr; // the core-side sub-expression..
   };
 
   class minus_expression final : public riddle::ast::minus_expression, public expression
   {
   public:
-    minus_expression(std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::minus_expression(std::move(e)) {}
+    minus_expression(std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::minus_expression(std::move(e)), c_xpr(to_core<ratio::core::expression>(xpr)) {}
     minus_expression(const minus_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_xpr; // the core-side sub-expression..
   };
 
   class not_expression final : public riddle::ast::not_expression, public expression
   {
   public:
-    not_expression(std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::not_expression(std::move(e)) {}
+    not_expression(std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::not_expression(std::move(e)), c_xpr(to_core<ratio::core::expression>(xpr)) {}
     not_expression(const not_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_xpr; // the core-side sub-expression..
   };
 
   class constructor_expression final : public riddle::ast::constructor_expression, public expression
   {
   public:
-    constructor_expression(std::vector<riddle::id_token> it, std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::constructor_expression(std::move(it), std::move(es)) {}
+    constructor_expression(std::vector<riddle::id_token> it, std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::constructor_expression(std::move(it), std::move(es)), c_xprs(to_core<ratio::core::expression>(expressions)) {}
     constructor_expression(const constructor_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    expr evaluate(scope &scp, context &ctx, std::vector<expr> exprs) const; // evaluates this expression given the values of its sub-expressions..
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    mutable type *c_tp = nullptr; // the resolved type of the new instance..
+    const std::vector<const ratio::core::expression *> c_xprs; // the core-side sub-expressions..
+    mutable call_cache<constructor> c_cache; // the constructors resolved at this call-site..
   };
 
   class eq_expression final : public riddle::ast::eq_expression, public expression
   {
   public:
-    eq_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::eq_expression(std::move(l), std::move(r)) {}
+    eq_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::eq_expression(std::move(l), std::move(r)), c_left(to_core<ratio::core::expression>(left)), c_right(to_core<ratio::core::expression>(right)) {}
     eq_expression(const eq_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_left, *c_right; // the core-side sub-expressions..
   };
 
   class neq_expression final : public riddle::ast::neq_expression, public expression
   {
   public:
-    neq_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::neq_expression(std::move(l), std::move(r)) {}
+    neq_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::neq_expression(std::move(l), std::move(r)), c_left(to_core<ratio::core::expression>(left)), c_right(to_core<ratio::core::expression>(right)) {}
     neq_expression(const neq_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_left, *c_right; // the core-side sub-expressions..
   };
 
   class lt_expression final : public riddle::ast::lt_expression, public expression
   {
   public:
-    lt_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::lt_expression(std::move(l), std::move(r)) {}
+    lt_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::lt_expression(std::move(l), std::move(r)), c_left(to_core<ratio::core::expression>(left)), c_right(to_core<ratio::core::expression>(right)) {}
     lt_expression(const lt_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_left, *c_right; // the core-side sub-expressions..
   };
 
   class leq_expression final : public riddle::ast::leq_expression, public expression
   {
   public:
-    leq_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::leq_expression(std::move(l), std::move(r)) {}
+    leq_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::leq_expression(std::move(l), std::move(r)), c_left(to_core<ratio::core::expression>(left)), c_right(to_core<ratio::core::expression>(right)) {}
     leq_expression(const leq_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_left, *c_right; // the core-side sub-expressions..
   };
 
   class geq_expression final : public riddle::ast::geq_expression, public expression
   {
   public:
-    geq_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::geq_expression(std::move(l), std::move(r)) {}
+    geq_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::geq_expression(std::move(l), std::move(r)), c_left(to_core<ratio::core::expression>(left)), c_right(to_core<ratio::core::expression>(right)) {}
     geq_expression(const geq_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_left, *c_right; // the core-side sub-expressions..
   };
 
   class gt_expression final : public riddle::ast::gt_expression, public expression
   {
   public:
-    gt_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::gt_expression(std::move(l), std::move(r)) {}
+    gt_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::gt_expression(std::move(l), std::move(r)), c_left(to_core<ratio::core::expression>(left)), c_right(to_core<ratio::core::expression>(right)) {}
     gt_expression(const gt_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_left, *c_right; // the core-side sub-expressions..
   };
 
   class function_expression final : public riddle::ast::function_expression, public expression
   {
   public:
-    function_expression(std::vector<riddle::id_token> is, const riddle::id_token &fn, std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::function_expression(std::move(is), fn, std::move(es)) {}
+    function_expression(std::vector<riddle::id_token> is, const riddle::id_token &fn, std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::function_expression(std::move(is), fn, std::move(es)), c_xprs(to_core<ratio::core::expression>(expressions)) {}
     function_expression(const function_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    expr evaluate(scope &scp, context &ctx, std::vector<expr> exprs) const; // evaluates this expression given the values of its sub-expressions..
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    mutable scope *c_scp = nullptr; // the resolved scope of the function, if explicitely declared..
+    const std::vector<const ratio::core::expression *> c_xprs; // the core-side sub-expressions..
+    mutable call_cache<method> c_cache; // the methods resolved at this call-site..
   };
 
   class id_expression final : public riddle::ast::id_expression, public expression
   {
   public:
-    id_expression(std::vector<riddle::id_token> is) : riddle::ast::id_expression(std::move(is)) {}
+    id_expression(std::vector<riddle::id_token> is) : riddle::ast::id_expression(std::move(is)), c_ids(to_symbols(ids)) {}
     id_expression(const id_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const std::vector<symbol> c_ids; // the interned identifiers..
   };
 
   class implication_expression final : public riddle::ast::implication_expression, public expression
   {
   public:
-    implication_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::implication_expression(std::move(l), std::move(r)) {}
+    implication_expression(std::unique_ptr<const riddle::ast::expression> l, std::unique_ptr<const riddle::ast::expression> r) : riddle::ast::implication_expression(std::move(l), std::move(r)), c_left(to_core<ratio::core::expression>(left)), c_right(to_core<ratio::core::expression>(right)) {}
     implication_expression(const implication_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_left, *c_right; // the core-side sub-expressions..
   };
 
   class disjunction_expression final : public riddle::ast::disjunction_expression, public expression
   {
   public:
-    disjunction_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::disjunction_expression(std::move(es)) {}
+    disjunction_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::disjunction_expression(std::move(es)), c_xprs(flatten<disjunction_expression>(expressions)) {}
     disjunction_expression(const disjunction_expression &orig) = delete;
 
+    const std::vector<const ratio::core::expression *> &get_operands() const noexcept { return c_xprs; }
+
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const std::vector<const ratio::core::expression *> c_xprs; // the core-side sub-expressions, with the nested disjunctions flattened..
   };
 
   class conjunction_expression final : public riddle::ast::conjunction_expression, public expression
   {
   public:
-    conjunction_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::conjunction_expression(std::move(es)) {}
+    conjunction_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::conjunction_expression(std::move(es)), c_xprs(flatten<conjunction_expression>(expressions)) {}
     conjunction_expression(const conjunction_expression &orig) = delete;
 
+    const std::vector<const ratio::core::expression *> &get_operands() const noexcept { return c_xprs; }
+
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const std::vector<const ratio::core::expression *> c_xprs; // the core-side sub-expressions, with the nested conjunctions flattened..
   };
 
   class exct_one_expression final : public riddle::ast::exct_one_expression, public expression
   {
   public:
-    exct_one_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::exct_one_expression(std::move(es)) {}
+    exct_one_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::exct_one_expression(std::move(es)), c_xprs(to_core<ratio::core::expression>(expressions)) {}
     exct_one_expression(const exct_one_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const std::vector<const ratio::core::expression *> c_xprs; // the core-side sub-expressions..
   };
 
   class addition_expression final : public riddle::ast::addition_expression, public expression
   {
   public:
-    addition_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::addition_expression(std::move(es)) {}
+    addition_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::addition_expression(std::move(es)), c_xprs(to_core<ratio::core::expression>(expressions)) {}
     addition_expression(const addition_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const std::vector<const ratio::core::expression *> c_xprs; // the core-side sub-expressions..
   };
 
   class subtraction_expression final : public riddle::ast::subtraction_expression, public expression
   {
   public:
-    subtraction_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::subtraction_expression(std::move(es)) {}
+    subtraction_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::subtraction_expression(std::move(es)), c_xprs(to_core<ratio::core::expression>(expressions)) {}
     subtraction_expression(const subtraction_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const std::vector<const ratio::core::expression *> c_xprs; // the core-side sub-expressions..
   };
 
   class multiplication_expression final : public riddle::ast::multiplication_expression, public expression
   {
   public:
-    multiplication_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::multiplication_expression(std::move(es)) {}
+    multiplication_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::multiplication_expression(std::move(es)), c_xprs(to_core<ratio::core::expression>(expressions)) {}
     multiplication_expression(const multiplication_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const std::vector<const ratio::core::expression *> c_xprs; // the core-side sub-expressions..
   };
 
   class division_expression final : public riddle::ast::division_expression, public expression
   {
   public:
-    division_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::division_expression(std::move(es)) {}
+    division_expression(std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::division_expression(std::move(es)), c_xprs(to_core<ratio::core::expression>(expressions)) {}
     division_expression(const division_expression &orig) = delete;
 
     expr evaluate(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    uint32_t compile(program &p) const override;
+
+  private:
+    const std::vector<const ratio::core::expression *> c_xprs; // the core-side sub-expressions..
   };
 
   class statement : public riddle::ast::statement
@@ -248,69 +477,139 @@ namespace ratio::core
     virtual ~statement() = default;
 
     virtual void execute(scope &scp, context &ctx) const = 0;
+    virtual void write(ast_writer &w) const = 0;
+    /**
+     * @brief Resolves, once and for all, the static references to types and predicates of this statement, and of its sub-statements, within the scope in which it is declared.
+     *
+     * @param scp The scope in which this statement is declared.
+     */
+    virtual void link(scope &) const {}
+    /**
+     * @brief Appends to the given program the instructions executing this statement.
+     *
+     * @param p The program to append the instructions to.
+     */
+    virtual void compile(program &p) const = 0;
   };
 
   class local_field_statement final : public riddle::ast::local_field_statement, public statement
   {
   public:
-    local_field_statement(std::vector<riddle::id_token> ft, std::vector<riddle::id_token> ns, std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::local_field_statement(std::move(ft), std::move(ns), std::move(es)) {}
+    local_field_statement(std::vector<riddle::id_token> ft, std::vector<riddle::id_token> ns, std::vector<std::unique_ptr<const riddle::ast::expression>> es) : riddle::ast::local_field_statement(std::move(ft), std::move(ns), std::move(es)), c_xprs(to_core<ratio::core::expression>(xprs)), c_names(to_symbols(names)) {}
     local_field_statement(const local_field_statement &orig) = delete;
 
     void execute(scope &scp, context &ctx) const override;
+    void execute(scope &scp, context &ctx, const size_t &i, expr val) const; // declares the `i`-th field with the given value (a default value if `nullptr`)..
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    void compile(program &p) const override;
+
+  private:
+    mutable type *c_tp = nullptr; // the resolved type of the fields..
+    const std::vector<const ratio::core::expression *> c_xprs; // the core-side initialization expressions..
+    const std::vector<symbol> c_names;                         // the interned names of the fields..
   };
 
   class assignment_statement final : public riddle::ast::assignment_statement, public statement
   {
   public:
-    assignment_statement(std::vector<riddle::id_token> is, const riddle::id_token &i, std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::assignment_statement(std::move(is), i, std::move(e)) {}
+    assignment_statement(std::vector<riddle::id_token> is, const riddle::id_token &i, std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::assignment_statement(std::move(is), i, std::move(e)), c_xpr(to_core<ratio::core::expression>(xpr)), c_ids(to_symbols(ids)), c_id(id.id) {}
     assignment_statement(const assignment_statement &orig) = delete;
 
     void execute(scope &scp, context &ctx) const override;
+    void execute(scope &scp, context &ctx, std::vector<expr> exprs) const; // executes this statement given the values of its expressions..
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    void compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_xpr; // the core-side expression..
+    const std::vector<symbol> c_ids;      // the interned identifiers of the assigned item..
+    const symbol c_id;                    // the interned name of the assigned field..
   };
 
   class expression_statement final : public riddle::ast::expression_statement, public statement
   {
   public:
-    expression_statement(std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::expression_statement(std::move(e)) {}
+    expression_statement(std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::expression_statement(std::move(e)), c_xpr(to_core<ratio::core::expression>(xpr)) {}
     expression_statement(const expression_statement &orig) = delete;
 
     void execute(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    void compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_xpr; // the core-side expression..
   };
 
   class disjunction_statement final : public riddle::ast::disjunction_statement, public statement
   {
   public:
-    disjunction_statement(std::vector<std::vector<std::unique_ptr<const riddle::ast::statement>>> conjs, std::vector<std::unique_ptr<const riddle::ast::expression>> conj_costs) : riddle::ast::disjunction_statement(std::move(conjs), std::move(conj_costs)) {}
+    disjunction_statement(std::vector<std::vector<std::unique_ptr<const riddle::ast::statement>>> conjs, std::vector<std::unique_ptr<const riddle::ast::expression>> conj_costs) : riddle::ast::disjunction_statement(std::move(conjs), std::move(conj_costs)), c_conjs(to_core<ratio::core::statement>(conjunctions)), c_costs(to_core<ratio::core::expression>(conjunction_costs)) {}
     disjunction_statement(const disjunction_statement &orig) = delete;
 
     void execute(scope &scp, context &ctx) const override;
+    void execute(scope &scp, context &ctx, std::vector<expr> exprs) const; // executes this statement given the values of its expressions..
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    void compile(program &p) const override;
+
+  private:
+    mutable std::vector<program> bodies; // the compiled bodies of the conjunctions..
+    const std::vector<std::vector<const ratio::core::statement *>> c_conjs; // the core-side statements of the conjunctions..
+    const std::vector<const ratio::core::expression *> c_costs;              // the core-side costs of the conjunctions..
   };
 
   class conjunction_statement final : public riddle::ast::conjunction_statement, public statement
   {
   public:
-    conjunction_statement(std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts) : riddle::ast::conjunction_statement(std::move(stmnts)) {}
+    conjunction_statement(std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts) : riddle::ast::conjunction_statement(std::move(stmnts)), c_stmnts(to_core<ratio::core::statement>(statements)) {}
     conjunction_statement(const conjunction_statement &orig) = delete;
 
     void execute(scope &scp, context &ctx) const override;
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    void compile(program &p) const override;
+
+  private:
+    const std::vector<const ratio::core::statement *> c_stmnts; // the core-side statements..
   };
 
   class formula_statement final : public riddle::ast::formula_statement, public statement
   {
   public:
-    formula_statement(const bool &isf, const riddle::id_token &fn, std::vector<riddle::id_token> scp, const riddle::id_token &pn, std::vector<riddle::id_token> assn_ns, std::vector<std::unique_ptr<const riddle::ast::expression>> assn_vs) : riddle::ast::formula_statement(isf, fn, std::move(scp), pn, std::move(assn_ns), std::move(assn_vs)) {}
+    formula_statement(const bool &isf, const riddle::id_token &fn, std::vector<riddle::id_token> scp, const riddle::id_token &pn, std::vector<riddle::id_token> assn_ns, std::vector<std::unique_ptr<const riddle::ast::expression>> assn_vs) : riddle::ast::formula_statement(isf, fn, std::move(scp), pn, std::move(assn_ns), std::move(assn_vs)), c_xprs(to_core<ratio::core::expression>(assignment_values)), c_name(formula_name.id), c_scope(to_symbols(formula_scope)), c_assn_names(to_symbols(assignment_names)) {}
     formula_statement(const formula_statement &orig) = delete;
 
     void execute(scope &scp, context &ctx) const override;
+    void execute(scope &scp, context &ctx, std::vector<expr> exprs) const; // executes this statement given the values of its expressions..
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    void compile(program &p) const override;
+
+  private:
+    mutable predicate *c_pred = nullptr; // the resolved predicate, if the scope of the formula is inherited..
+    const std::vector<const ratio::core::expression *> c_xprs; // the core-side assignment values..
+    const symbol c_name;                                       // the interned name of the formula..
+    const std::vector<symbol> c_scope;                         // the interned scope of the formula..
+    const std::vector<symbol> c_assn_names;                    // the interned assignment names..
   };
 
   class return_statement final : public riddle::ast::return_statement, public statement
   {
   public:
-    return_statement(std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::return_statement(std::move(e)) {}
+    return_statement(std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::return_statement(std::move(e)), c_xpr(to_core<ratio::core::expression>(xpr)) {}
     return_statement(const return_statement &orig) = delete;
 
     void execute(scope &scp, context &ctx) const override;
+    void execute(scope &scp, context &ctx, std::vector<expr> exprs) const; // executes this statement given the values of its expressions..
+    void write(ast_writer &w) const override;
+    void link(scope &scp) const override;
+    void compile(program &p) const override;
+
+  private:
+    const ratio::core::expression *c_xpr; // the core-side expression..
   };
 
   class type_declaration : public riddle::ast::type_declaration
@@ -319,36 +618,69 @@ namespace ratio::core
     type_declaration() = default;
     type_declaration(const type_declaration &orig) = delete;
 
+    virtual const std::string &get_name() const noexcept = 0;
     virtual void declare(scope &) const {}
     virtual void refine(scope &) const {}
+    virtual void write(ast_writer &w) const = 0;
+    virtual void link(scope &) const {}
+    virtual bool is_reloadable(const type_declaration &old) const;
+    virtual void reload(scope &, const type_declaration &) const {}
+    virtual bool retains_statements() const noexcept { return false; }
   };
 
   class method_declaration final : public riddle::ast::method_declaration
   {
   public:
-    method_declaration(std::vector<riddle::id_token> rt, const riddle::id_token &n, std::vector<std::pair<const std::vector<riddle::id_token>, const riddle::id_token>> pars, std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts) : riddle::ast::method_declaration(std::move(rt), n, std::move(pars), std::move(stmnts)) {}
+    method_declaration(std::vector<riddle::id_token> rt, const riddle::id_token &n, std::vector<std::pair<const std::vector<riddle::id_token>, const riddle::id_token>> pars, std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts) : riddle::ast::method_declaration(std::move(rt), n, std::move(pars), std::move(stmnts)), c_stmnts(to_core<ratio::core::statement>(statements)) {}
     method_declaration(const method_declaration &orig) = delete;
 
     void refine(scope &scp) const;
+    void link(scope &scp) const;
+    void write(ast_writer &w) const;
+    bool is_reloadable(const method_declaration &old) const;
+    void reload(scope &scp, const method_declaration &old) const;
+    std::string get_signature() const;
+    bool retains_statements() const noexcept { return body.contains(opcode::disjunction); } // the disjunctions created by the body refer to its statements..
+
+  private:
+    mutable program body; // the compiled body..
+    const std::vector<const ratio::core::statement *> c_stmnts; // the core-side statements..
   };
 
   class predicate_declaration final : public riddle::ast::predicate_declaration
   {
   public:
-    predicate_declaration(const riddle::id_token &n, std::vector<std::pair<const std::vector<riddle::id_token>, const riddle::id_token>> pars, std::vector<std::vector<riddle::id_token>> pl, std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts) : riddle::ast::predicate_declaration(n, std::move(pars), std::move(pl), std::move(stmnts)) {}
+    predicate_declaration(const riddle::id_token &n, std::vector<std::pair<const std::vector<riddle::id_token>, const riddle::id_token>> pars, std::vector<std::vector<riddle::id_token>> pl, std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts) : riddle::ast::predicate_declaration(n, std::move(pars), std::move(pl), std::move(stmnts)), c_stmnts(to_core<ratio::core::statement>(statements)) {}
     predicate_declaration(const predicate_declaration &orig) = delete;
 
     void declare(scope &scp) const;
     void refine(scope &scp) const;
+    void link(scope &scp) const;
+    void write(ast_writer &w) const;
+    bool is_reloadable(const predicate_declaration &old) const;
+    void reload(scope &scp, const predicate_declaration &old) const;
+    const std::string &get_name() const noexcept { return name.id; }
+    bool retains_statements() const noexcept { return body.contains(opcode::disjunction); } // the disjunctions created by the body refer to its statements..
+
+  private:
+    mutable program body; // the compiled body..
+    const std::vector<const ratio::core::statement *> c_stmnts; // the core-side statements..
   };
 
   class typedef_declaration final : public riddle::ast::typedef_declaration, public type_declaration
   {
   public:
-    typedef_declaration(const riddle::id_token &n, const riddle::id_token &pt, std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::typedef_declaration(n, pt, std::move(e)) {}
+    typedef_declaration(const riddle::id_token &n, const riddle::id_token &pt, std::unique_ptr<const riddle::ast::expression> e) : riddle::ast::typedef_declaration(n, pt, std::move(e)), c_xpr(to_core<ratio::core::expression>(xpr)) {}
     typedef_declaration(const typedef_declaration &orig) = delete;
 
+    const std::string &get_name() const noexcept override { return name.id; }
     void declare(scope &scp) const override;
+    void link(scope &scp) const override;
+    void write(ast_writer &w) const override;
+    void reload(scope &scp, const ratio::core::type_declaration &old) const override;
+
+  private:
+    const ratio::core::expression *c_xpr; // the core-side expression..
   };
 
   class enum_declaration final : public riddle::ast::enum_declaration, public type_declaration
@@ -357,8 +689,10 @@ namespace ratio::core
     enum_declaration(const riddle::id_token &n, std::vector<riddle::string_token> es, std::vector<std::vector<riddle::id_token>> trs) : riddle::ast::enum_declaration(n, std::move(es), std::move(trs)) {}
     enum_declaration(const enum_declaration &orig) = delete;
 
+    const std::string &get_name() const noexcept override { return name.id; }
     void declare(scope &scp) const override;
     void refine(scope &scp) const override;
+    void write(ast_writer &w) const override;
   };
 
   class variable_declaration final : public riddle::ast::variable_declaration
@@ -366,8 +700,13 @@ namespace ratio::core
     friend class field_declaration;
 
   public:
-    variable_declaration(const riddle::id_token &n, std::unique_ptr<const riddle::ast::expression> e = nullptr) : riddle::ast::variable_declaration(n, std::move(e)) {}
+    variable_declaration(const riddle::id_token &n, std::unique_ptr<const riddle::ast::expression> e = nullptr) : riddle::ast::variable_declaration(n, std::move(e)), c_xpr(to_core<ratio::core::expression>(xpr)) {}
     variable_declaration(const variable_declaration &orig) = delete;
+
+    void write(ast_writer &w) const;
+
+  private:
+    const ratio::core::expression *c_xpr; // the core-side initialization expression..
   };
 
   class field_declaration final : public riddle::ast::field_declaration
@@ -377,36 +716,109 @@ namespace ratio::core
     field_declaration(const field_declaration &orig) = delete;
 
     void refine(scope &scp) const;
+    void link(scope &scp) const;
+    void write(ast_writer &w) const;
+    void reload(scope &scp) const;
   };
 
   class constructor_declaration final : public riddle::ast::constructor_declaration
   {
   public:
-    constructor_declaration(std::vector<std::pair<const std::vector<riddle::id_token>, const riddle::id_token>> pars, std::vector<riddle::id_token> ins, std::vector<std::vector<std::unique_ptr<const riddle::ast::expression>>> ivs, std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts) : riddle::ast::constructor_declaration(std::move(pars), std::move(ins), std::move(ivs), std::move(stmnts)) {}
+    constructor_declaration(std::vector<std::pair<const std::vector<riddle::id_token>, const riddle::id_token>> pars, std::vector<riddle::id_token> ins, std::vector<std::vector<std::unique_ptr<const riddle::ast::expression>>> ivs, std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts) : riddle::ast::constructor_declaration(std::move(pars), std::move(ins), std::move(ivs), std::move(stmnts)), c_init_names(to_symbols(init_names)), c_init_vals(to_core<ratio::core::expression>(init_vals)), c_stmnts(to_core<ratio::core::statement>(statements)) {}
     constructor_declaration(const constructor_declaration &orig) = delete;
 
     void refine(scope &scp) const;
+    void link(scope &scp) const;
+    void write(ast_writer &w) const;
+    void reload(type &tp, const constructor_declaration &old) const;
+    std::string get_signature() const;
+    bool retains_statements() const noexcept { return body.contains(opcode::disjunction); } // the disjunctions created by the body refer to its statements..
+
+  private:
+    mutable program body; // the compiled body..
+    const std::vector<symbol> c_init_names;                                      // the interned names in the init-list..
+    const std::vector<std::vector<const ratio::core::expression *>> c_init_vals; // the core-side initialization values..
+    const std::vector<const ratio::core::statement *> c_stmnts;                  // the core-side statements..
   };
 
   class class_declaration final : public riddle::ast::class_declaration, public type_declaration
   {
   public:
-    class_declaration(const riddle::id_token &n, std::vector<std::vector<riddle::id_token>> bcs, std::vector<std::unique_ptr<const riddle::ast::field_declaration>> fs, std::vector<std::unique_ptr<const riddle::ast::constructor_declaration>> cs, std::vector<std::unique_ptr<const riddle::ast::method_declaration>> ms, std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> ps, std::vector<std::unique_ptr<const riddle::ast::type_declaration>> ts) : riddle::ast::class_declaration(n, std::move(bcs), std::move(fs), std::move(cs), std::move(ms), std::move(ps), std::move(ts)) {}
+    class_declaration(const riddle::id_token &n, std::vector<std::vector<riddle::id_token>> bcs, std::vector<std::unique_ptr<const riddle::ast::field_declaration>> fs, std::vector<std::unique_ptr<const riddle::ast::constructor_declaration>> cs, std::vector<std::unique_ptr<const riddle::ast::method_declaration>> ms, std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> ps, std::vector<std::unique_ptr<const riddle::ast::type_declaration>> ts) : riddle::ast::class_declaration(n, std::move(bcs), std::move(fs), std::move(cs), std::move(ms), std::move(ps), std::move(ts)), c_types(to_core<ratio::core::type_declaration>(types)) {}
     class_declaration(const class_declaration &orig) = delete;
 
+    const std::string &get_name() const noexcept override { return name.id; }
     void declare(scope &scp) const override;
     void refine(scope &scp) const override;
+    void link(scope &scp) const override;
+    void write(ast_writer &w) const override;
+    bool is_reloadable(const ratio::core::type_declaration &old) const override;
+    void reload(scope &scp, const ratio::core::type_declaration &old) const override;
+    bool retains_statements() const noexcept override;
+
+  private:
+    const std::vector<const ratio::core::type_declaration *> c_types; // the core-side nested types..
   };
 
   class compilation_unit final : public riddle::ast::compilation_unit
   {
   public:
-    compilation_unit(std::vector<std::unique_ptr<const riddle::ast::method_declaration>> ms, std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> ps, std::vector<std::unique_ptr<const riddle::ast::type_declaration>> ts, std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts) : riddle::ast::compilation_unit(std::move(ms), std::move(ps), std::move(ts), std::move(stmnts)) {}
+    compilation_unit(std::vector<std::unique_ptr<const riddle::ast::method_declaration>> ms, std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> ps, std::vector<std::unique_ptr<const riddle::ast::type_declaration>> ts, std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts) : riddle::ast::compilation_unit(std::move(ms), std::move(ps), std::move(ts), std::move(stmnts)), c_types(to_core<ratio::core::type_declaration>(types)), c_stmnts(to_core<ratio::core::statement>(statements)) {}
     compilation_unit(const compilation_unit &orig) = delete;
 
     void declare(scope &scp) const;
     void refine(scope &scp) const;
+    /**
+     * @brief Resolves, once and for all, the static references to types and predicates of the bodies and of the statements of this compilation unit, so that their execution requires no name lookup.
+     *
+     * @param scp The scope in which this compilation unit has been read.
+     */
+    void link(scope &scp) const;
     void execute(scope &scp, context &ctx) const;
+    void write(ast_writer &w) const;
+    /**
+     * @brief Checks whether this compilation unit contains any type, method or predicate declaration.
+     *
+     * @return true If this compilation unit contains any declaration.
+     * @return false If this compilation unit contains only statements.
+     */
+    bool has_declarations() const noexcept { return !types.empty() || !methods.empty() || !predicates.empty(); }
+    /**
+     * @brief Checks whether the items created by executing this compilation unit might refer to its statements, which is the case for disjunctions, so that it must outlive them.
+     *
+     * @return true If this compilation unit must outlive its execution.
+     * @return false If this compilation unit can be released after its execution.
+     */
+    bool retains_statements() const noexcept;
+    /**
+     * @brief Checks whether the items created by executing either the statements or the bodies of the declarations of this compilation unit might refer to its nodes, so that it must outlive them even once replaced by a reload.
+     *
+     * @return true If this compilation unit must outlive its replacement.
+     * @return false If this compilation unit can be released once replaced.
+     */
+    bool retains_nodes() const noexcept;
+    /**
+     * @brief Checks whether this compilation unit can replace the `old` one incrementally.
+     *
+     * This is the case if no declaration has been removed, if the signatures of the methods, the predicates and the constructors, as well as the fields and the base classes of the types, are unchanged, and if the statements of the `old` compilation unit are a prefix of the statements of this one.
+     *
+     * @param old The compilation unit to be replaced.
+     * @return true If this compilation unit can replace the `old` one incrementally.
+     * @return false If this compilation unit cannot replace the `old` one incrementally.
+     */
+    bool is_reloadable(const compilation_unit &old) const;
+    /**
+     * @brief Replaces the `old` compilation unit, declaring and refining the new declarations, rebinding the bodies of the existing ones and executing the appended statements.
+     *
+     * @param scp The scope in which the `old` compilation unit has been read.
+     * @param ctx The context in which the `old` compilation unit has been executed.
+     * @param old The compilation unit to be replaced.
+     */
+    void reload(scope &scp, context &ctx, const compilation_unit &old) const;
+
+  private:
+    const std::vector<const ratio::core::type_declaration *> c_types; // the core-side types..
+    const std::vector<const ratio::core::statement *> c_stmnts;       // the core-side statements..
   };
 
   class parser : public riddle::parser
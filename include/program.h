@@ -0,0 +1,120 @@
+#pragma once
+#include "core_defs.h"
+#include <vector>
+#include <cstdint>
+
+namespace ratio::core
+{
+  class scope;
+
+  /**
+   * @brief The operations of a compiled body.
+   *
+   */
+  enum class opcode : uint8_t
+  {
+    // the expressions..
+    new_bool,     // creates a bool constant..
+    new_int,      // creates an int constant..
+    new_real,     // creates a real constant..
+    new_string,   // creates a string constant..
+    get,          // gets the value of a (possibly qualified) variable..
+    minus,        // computes the opposite of the operand..
+    negate,       // computes the negation of the operand..
+    eq,           // computes the equality of the two operands..
+    neq,          // computes the inequality of the two operands..
+    lt,           // computes the less-than relation of the two operands..
+    leq,          // computes the less-than-or-equal relation of the two operands..
+    geq,          // computes the greater-than-or-equal relation of the two operands..
+    gt,           // computes the greater-than relation of the two operands..
+    implication,  // computes the implication of the two operands..
+    disj,         // computes the disjunction of the operands..
+    conj,         // computes the conjunction of the operands..
+    exct_one,     // computes the exclusive disjunction of the operands..
+    add,          // computes the sum of the operands..
+    sub,          // computes the difference of the operands..
+    mult,         // computes the product of the operands..
+    div,          // computes the quotient of the operands..
+    new_instance, // invokes a constructor with the operands as arguments..
+    invoke,       // invokes a method with the operands as arguments..
+    // the statements..
+    local_field, // declares a local field initialized with the operand..
+    assign,      // assigns the operand to a field..
+    assert_fact, // asserts the operand..
+    disjunction, // creates a disjunction whose disjuncts have the operands as costs..
+    formula,     // creates a new atom whose arguments are the operands..
+    ret          // returns the operand..
+  };
+
+  /**
+   * @brief An instruction of a compiled body.
+   *
+   * The operands are identified by a range within the operands of the program, each referring to the register holding its value.
+   */
+  struct instruction
+  {
+    opcode op;          // the operation..
+    uint32_t dst;       // the register holding the result of the operation, if any..
+    uint32_t first;     // the index of the first operand..
+    uint32_t count;     // the number of operands..
+    uint32_t arg;       // an immediate argument of the operation (e.g., the index of the declared local field)..
+    const void *node;   // the node of the abstract syntax tree the instruction has been compiled from..
+  };
+
+  /**
+   * @brief A body (of a predicate, a method, a constructor or a conjunction) compiled, once linked, into a flat sequence of instructions operating on registers.
+   *
+   */
+  class program
+  {
+  public:
+    static constexpr uint32_t no_reg = UINT32_MAX; // the register of an absent operand..
+
+    program() = default;
+    program(const program &orig) = delete;
+    program(program &&orig) = default;
+    program &operator=(program &&orig) = default;
+
+    /**
+     * @brief Appends a new instruction to this program.
+     *
+     * @param op The operation of the new instruction.
+     * @param node The node of the abstract syntax tree the instruction is compiled from.
+     * @param ops The registers of the operands of the new instruction (`no_reg` for absent operands).
+     * @param arg The immediate argument of the new instruction.
+     * @return uint32_t The register holding the result of the new instruction.
+     */
+    RATIOCORE_EXPORT uint32_t emit(const opcode &op, const void *node, const std::vector<uint32_t> &ops = {}, const uint32_t &arg = 0);
+
+    /**
+     * @brief Removes all the instructions of this program.
+     *
+     */
+    RATIOCORE_EXPORT void clear() noexcept;
+
+    /**
+     * @brief Checks whether this program contains any instruction with the given operation.
+     *
+     * @param op The operation to look for.
+     * @return true If this program contains an instruction with the given operation.
+     * @return false If this program contains no instruction with the given operation.
+     */
+    RATIOCORE_EXPORT bool contains(const opcode &op) const noexcept;
+
+    /**
+     * @brief Runs this program within the given scope and context.
+     *
+     * @param scp The scope in which the program runs.
+     * @param ctx The context in which the program runs.
+     */
+    RATIOCORE_EXPORT void run(scope &scp, context &ctx) const;
+
+  private:
+    std::vector<expr> get_operands(const std::vector<expr> &regs, const instruction &i) const;
+
+  private:
+    std::vector<instruction> code; // the instructions of the program..
+    std::vector<uint32_t> ops;     // the registers of the operands of the instructions..
+    uint32_t n_regs = 0;           // the number of registers..
+  };
+} // namespace ratio::core
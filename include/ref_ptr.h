@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace ratio::core
+{
+  /**
+   * @brief An object counting the handles referring to it.
+   *
+   * The count is not atomic, hence the handles of an object must not be copied or destroyed concurrently.
+   */
+  class ref_counted
+  {
+    template <typename Tp>
+    friend class ref_ptr;
+
+  public:
+    ref_counted() = default;
+    ref_counted(const ref_counted &) noexcept {} // copies do not share the count of the original..
+    ref_counted &operator=(const ref_counted &) noexcept { return *this; }
+    virtual ~ref_counted() = default;
+
+  private:
+    mutable unsigned ref_count = 0; // the number of handles referring to this object..
+  };
+
+  /**
+   * @brief A handle to a reference counted object, deleting the object when the last handle referring to it is destroyed.
+   *
+   * Unlike `std::shared_ptr`, the count is stored within the object and is not atomic, and the handle is as large as a pointer.
+   * Since the handle stores the counted part of the object, copying and destroying a handle do not require the type of the object to be complete.
+   */
+  template <typename Tp>
+  class ref_ptr
+  {
+    template <typename Up>
+    friend class ref_ptr;
+
+  public:
+    using element_type = Tp;
+
+    constexpr ref_ptr() noexcept = default;
+    constexpr ref_ptr(std::nullptr_t) noexcept {}
+    explicit ref_ptr(Tp *p) noexcept : ptr(p) { add_ref(); }
+    ref_ptr(const ref_ptr &other) noexcept : ptr(other.ptr) { add_ref(); }
+    ref_ptr(ref_ptr &&other) noexcept : ptr(std::exchange(other.ptr, nullptr)) {}
+    template <typename Up, typename = std::enable_if_t<std::is_convertible_v<Up *, Tp *>>>
+    ref_ptr(const ref_ptr<Up> &other) noexcept : ptr(other.ptr) { add_ref(); }
+    template <typename Up, typename = std::enable_if_t<std::is_convertible_v<Up *, Tp *>>>
+    ref_ptr(ref_ptr<Up> &&other) noexcept : ptr(std::exchange(other.ptr, nullptr)) {}
+    ~ref_ptr() { release(); }
+
+    ref_ptr &operator=(ref_ptr other) noexcept
+    {
+      std::swap(ptr, other.ptr);
+      return *this;
+    }
+
+    Tp *get() const noexcept { return static_cast<Tp *>(ptr); }
+    Tp &operator*() const noexcept { return *get(); }
+    Tp *operator->() const noexcept { return get(); }
+    explicit operator bool() const noexcept { return ptr; }
+
+    void reset() noexcept { ref_ptr().swap(*this); }
+    void swap(ref_ptr &other) noexcept { std::swap(ptr, other.ptr); }
+
+    unsigned use_count() const noexcept { return ptr ? ptr->ref_count : 0; }
+
+    friend bool operator==(const ref_ptr &lhs, const ref_ptr &rhs) noexcept { return lhs.ptr == rhs.ptr; }
+    friend bool operator!=(const ref_ptr &lhs, const ref_ptr &rhs) noexcept { return lhs.ptr != rhs.ptr; }
+    friend bool operator==(const ref_ptr &lhs, std::nullptr_t) noexcept { return !lhs.ptr; }
+    friend bool operator!=(const ref_ptr &lhs, std::nullptr_t) noexcept { return lhs.ptr; }
+
+  private:
+    void add_ref() const noexcept
+    {
+      if (ptr)
+        ++ptr->ref_count;
+    }
+    void release() noexcept
+    {
+      if (ptr && !--ptr->ref_count)
+        delete ptr;
+    }
+
+  private:
+    ref_counted *ptr = nullptr; // the counted part of the referred object..
+
+    friend struct std::hash<ref_ptr>;
+  };
+} // namespace ratio::core
+
+namespace std
+{
+  template <typename Tp>
+  struct hash<ratio::core::ref_ptr<Tp>>
+  {
+    size_t operator()(const ratio::core::ref_ptr<Tp> &p) const noexcept { return hash<const ratio::core::ref_counted *>()(p.ptr); }
+  };
+} // namespace std
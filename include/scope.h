@@ -32,6 +32,13 @@ namespace ratio::core
      */
     inline scope &get_scope() const { return scp; }
 
+    /**
+     * @brief Find the field in the current scope with the given name, searching in the enclosing scopes if not found in the current scope.
+     *
+     * @param name the name of the field.
+     * @return const field* The field in the current scope with the given name, or `nullptr` if there is no such field.
+     */
+    RATIOCORE_EXPORT virtual const field *find_field(const std::string &name) const noexcept;
     /**
      * @brief Get the field in the current scope with the given name, searching in the enclosing scopes if not found in the current scope.
      *
@@ -39,7 +46,7 @@ namespace ratio::core
      * @return const field& The field in the current scope with the given name.
      * @throws std::out_of_range Thrown if there is no field with the given name.
      */
-    RATIOCORE_EXPORT virtual const field &get_field(const std::string &name) const;
+    RATIOCORE_EXPORT const field &get_field(const std::string &name) const;
     /**
      * @brief Get the fields defined within this scope.
      *
@@ -47,6 +54,14 @@ namespace ratio::core
      */
     const std::map<std::string, field_ptr> &get_fields() const noexcept { return fields; }
 
+    /**
+     * @brief Find the method in the current scope with the given name and the given parameter types, searching in the enclosing scopes if not found in the current scope.
+     *
+     * @param name The name of the desired method.
+     * @param ts The parameter types of the desired method.
+     * @return method* The method in the current scope with the given name, or `nullptr` if there is no such method.
+     */
+    RATIOCORE_EXPORT virtual method *find_method(const std::string &name, const std::vector<const type *> &ts) const noexcept;
     /**
      * @brief Get the method in the current scope with the given name and the given parameter types, searching in the enclosing scopes if not found in the current scope.
      *
@@ -55,7 +70,7 @@ namespace ratio::core
      * @return method& The method in the current scope with the given name.
      * @throws std::out_of_range Thrown if there is no method with the given name.
      */
-    RATIOCORE_EXPORT virtual method &get_method(const std::string &name, const std::vector<const type *> &ts) const;
+    RATIOCORE_EXPORT method &get_method(const std::string &name, const std::vector<const type *> &ts) const;
     /**
      * @brief Get the methods defined within this scope.
      *
@@ -63,6 +78,13 @@ namespace ratio::core
      */
     RATIOCORE_EXPORT virtual const std::map<std::string, std::vector<method_ptr>> &get_methods() const noexcept;
 
+    /**
+     * @brief Find the type in the current scope with the given name, searching in the enclosing scopes if not found in the current scope.
+     *
+     * @param name The name of the desired type.
+     * @return type* The type in the current scope with the given name, or `nullptr` if there is no such type.
+     */
+    RATIOCORE_EXPORT virtual type *find_type(const std::string &name) const noexcept;
     /**
      * @brief Get the type in the current scope with the given name, searching in the enclosing scopes if not found in the current scope.
      *
@@ -70,7 +92,7 @@ namespace ratio::core
      * @return type& The type in the current scope with the given name.
      * @throws std::out_of_range Thrown if there is no type with the given name.
      */
-    RATIOCORE_EXPORT virtual type &get_type(const std::string &name) const;
+    RATIOCORE_EXPORT type &get_type(const std::string &name) const;
 
     /**
      * @brief Get the types defined within this scope.
@@ -79,6 +101,13 @@ namespace ratio::core
      */
     RATIOCORE_EXPORT virtual const std::map<std::string, type_ptr> &get_types() const noexcept;
 
+    /**
+     * @brief Find the predicate in the current scope with the given name, searching in the enclosing scopes if not found in the current scope.
+     *
+     * @param name The name of the desired predicate.
+     * @return predicate* The predicate in the current scope with the given name, or `nullptr` if there is no such predicate.
+     */
+    RATIOCORE_EXPORT virtual predicate *find_predicate(const std::string &name) const noexcept;
     /**
      * @brief Get the predicate in the current scope with the given name, searching in the enclosing scopes if not found in the current scope.
      *
@@ -86,7 +115,7 @@ namespace ratio::core
      * @return predicate& The predicate in the current scope with the given name.
      * @throws std::out_of_range Thrown if there is no predicate with the given name.
      */
-    RATIOCORE_EXPORT virtual predicate &get_predicate(const std::string &name) const;
+    RATIOCORE_EXPORT predicate &get_predicate(const std::string &name) const;
     /**
      * @brief Get the predicates defined within this scope.
      *
@@ -0,0 +1,68 @@
+#pragma once
+#include "ratiocore_export.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <optional>
+
+namespace ratio::core
+{
+  /**
+   * @brief An interned name.
+   *
+   * Names are interned into dense integers once, typically when the riddle code is parsed, so that comparing and hashing names amounts to comparing and hashing integers.
+   * The interned names are shared by all the cores, since riddle files might be parsed in parallel. Interned names are never moved, so that symbols refer to their text directly and reading it requires no synchronization. Each thread caches the symbols it has interned or found, so that repeated lookups by name do not contend on the lock of the shared table.
+   * Interned names are never released, hence the table grows with the distinct names of all the code read by the process.
+   */
+  class symbol
+  {
+  public:
+    /**
+     * @brief Interns the given name.
+     *
+     * @param name The name to intern.
+     */
+    RATIOCORE_EXPORT explicit symbol(std::string_view name);
+    /**
+     * @brief Gets the symbol identified by the given dense integer, which must have been previously interned.
+     *
+     * @param id The dense integer identifying the interned name.
+     */
+    RATIOCORE_EXPORT explicit symbol(const uint32_t &id) noexcept;
+    constexpr symbol(const uint32_t &id, const std::string &name) noexcept : id(id), name(&name) {}
+
+    /**
+     * @brief Looks for the given name among the interned ones, without interning it.
+     *
+     * @param name The name to look for.
+     * @return std::optional<symbol> The symbol of the given name, or an empty optional if the name has never been interned.
+     */
+    RATIOCORE_EXPORT static std::optional<symbol> find(std::string_view name) noexcept;
+
+    /**
+     * @brief Gets the interned name.
+     *
+     * @return const std::string& The interned name.
+     */
+    const std::string &str() const noexcept { return *name; }
+    /**
+     * @brief Gets the dense integer identifying the interned name.
+     *
+     * @return uint32_t The dense integer identifying the interned name.
+     */
+    constexpr uint32_t get_id() const noexcept { return id; }
+
+    friend constexpr bool operator==(const symbol &lhs, const symbol &rhs) noexcept { return lhs.id == rhs.id; }
+    friend constexpr bool operator!=(const symbol &lhs, const symbol &rhs) noexcept { return lhs.id != rhs.id; }
+
+  private:
+    uint32_t id;             // the dense integer identifying the interned name..
+    const std::string *name; // the interned name..
+  };
+
+  RATIOCORE_EXPORT extern const std::string keyword_names[3]; // the text of the predefined symbols..
+
+  inline constexpr symbol this_sym{0, keyword_names[0]};   // the interned `this` keyword..
+  inline constexpr symbol return_sym{1, keyword_names[1]}; // the interned `return` keyword..
+  inline constexpr symbol tau_sym{2, keyword_names[2]};    // the interned `tau` keyword..
+} // namespace ratio::core
@@ -0,0 +1,130 @@
+#pragma once
+#include "symbol.h"
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+
+namespace ratio::core
+{
+  /**
+   * @brief A flat map from symbols to values.
+   *
+   * The entries are stored contiguously, in insertion order, and are indexed, once the map grows beyond `linear_limit` entries, by an open-addressing hash table with linear probing on the symbols' dense integers.
+   * Entries cannot be erased, hence iterators are invalidated only by insertions.
+   */
+  template <typename Tp>
+  class symbol_map
+  {
+  public:
+    using value_type = std::pair<symbol, Tp>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    static constexpr size_t linear_limit = 8; // small maps are scanned linearly..
+
+    iterator begin() noexcept { return entries.begin(); }
+    iterator end() noexcept { return entries.end(); }
+    const_iterator begin() const noexcept { return entries.cbegin(); }
+    const_iterator end() const noexcept { return entries.cend(); }
+    const_iterator cbegin() const noexcept { return entries.cbegin(); }
+    const_iterator cend() const noexcept { return entries.cend(); }
+
+    bool empty() const noexcept { return entries.empty(); }
+    size_t size() const noexcept { return entries.size(); }
+    void reserve(const size_t &n)
+    {
+      entries.reserve(n);
+      if (n > linear_limit && index.size() < 2 * n)
+        rehash(2 * n);
+    }
+
+    iterator find(const symbol &s) noexcept { return entries.begin() + position(s); }
+    const_iterator find(const symbol &s) const noexcept { return entries.cbegin() + position(s); }
+    size_t count(const symbol &s) const noexcept { return position(s) != entries.size(); }
+
+    Tp &at(const symbol &s)
+    {
+      if (const auto pos = position(s); pos != entries.size())
+        return entries[pos].second;
+      throw std::out_of_range(s.str());
+    }
+    const Tp &at(const symbol &s) const
+    {
+      if (const auto pos = position(s); pos != entries.size())
+        return entries[pos].second;
+      throw std::out_of_range(s.str());
+    }
+
+    /**
+     * @brief Inserts a new entry, constructing its value from the given arguments, unless the map already contains the given symbol.
+     *
+     * @return std::pair<iterator, bool> The entry having the given symbol and whether it has been inserted.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const symbol &s, Args &&...args)
+    {
+      if (const auto pos = position(s); pos != entries.size())
+        return {entries.begin() + pos, false};
+      entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(s), std::forward_as_tuple(std::forward<Args>(args)...));
+      if (index.empty() ? entries.size() > linear_limit : 2 * entries.size() > index.size())
+        rehash(4 * entries.size());
+      else if (!index.empty())
+        insert_index(entries.size() - 1);
+      return {std::prev(entries.end()), true};
+    }
+
+    template <typename It>
+    void insert(It first, It last)
+    {
+      for (; first != last; ++first)
+        emplace(first->first, first->second);
+    }
+
+  private:
+    static size_t hash(const symbol &s) noexcept { return s.get_id() * size_t(0x9E3779B97F4A7C15ull); }
+
+    /**
+     * Returns the position of the entry having the given symbol, or the number of entries if there is no such entry.
+     */
+    size_t position(const symbol &s) const noexcept
+    {
+      if (index.empty())
+      {
+        for (size_t i = 0; i < entries.size(); ++i)
+          if (entries[i].first == s)
+            return i;
+        return entries.size();
+      }
+      for (size_t slot = hash(s) & (index.size() - 1);; slot = (slot + 1) & (index.size() - 1))
+        if (index[slot] == no_entry)
+          return entries.size();
+        else if (entries[index[slot]].first == s)
+          return index[slot];
+    }
+
+    void insert_index(const size_t &pos) noexcept
+    {
+      size_t slot = hash(entries[pos].first) & (index.size() - 1);
+      while (index[slot] != no_entry)
+        slot = (slot + 1) & (index.size() - 1);
+      index[slot] = static_cast<uint32_t>(pos);
+    }
+
+    void rehash(const size_t &min_slots)
+    {
+      size_t n_slots = 16;
+      while (n_slots < min_slots)
+        n_slots <<= 1;
+      index.assign(n_slots, no_entry);
+      for (size_t pos = 0; pos < entries.size(); ++pos)
+        insert_index(pos);
+    }
+
+  private:
+    static constexpr uint32_t no_entry = UINT32_MAX;
+    std::vector<value_type> entries; // the entries, in insertion order..
+    std::vector<uint32_t> index;     // the positions of the entries, hashed by their symbols (empty while the map is small)..
+  };
+} // namespace ratio::core
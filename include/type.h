@@ -1,15 +1,13 @@
 #pragma once
 #include "scope.h"
+#include "symbol_map.h"
 #include <string>
 #include <vector>
-
-namespace riddle::ast
-{
-  class expression;
-} // namespace riddle
+#include <cstdint>
 
 namespace ratio::core
 {
+  class expression;
   class method_declaration;
   class predicate_declaration;
   class typedef_declaration;
@@ -26,6 +24,7 @@ namespace ratio::core
     friend class enum_declaration;
     friend class constructor_declaration;
     friend class class_declaration;
+    friend class core;
 
   public:
     RATIOCORE_EXPORT type(scope &scp, const std::string &name, bool primitive = false);
@@ -46,14 +45,45 @@ namespace ratio::core
     }                                                                                 // returns the full name of this type..
     inline bool is_primitive() const noexcept { return primitive; }                   // returns whether this type is primitive..
     const std::vector<type *> &get_supertypes() const noexcept { return supertypes; } // returns the base types of this type..
-
-    RATIOCORE_EXPORT virtual bool is_assignable_from(const type &t) const noexcept; // checks whether this type is assignable from the 't' type..
-
-    RATIOCORE_EXPORT virtual expr new_instance();                         // creates a new instance of this type..
-    RATIOCORE_EXPORT virtual expr new_existential();                      // creates a new existential of this type (i.e. an object variable whose allowed values are all the current instances of this type)..
-    std::vector<expr> get_instances() const noexcept { return instances; } // returns the instances of this type..
+    /**
+     * @brief Get this type and, transitively, its supertypes, each appearing once, in depth-first order.
+     *
+     * @return const std::vector<type *>& This type and, transitively, its supertypes.
+     */
+    RATIOCORE_EXPORT const std::vector<type *> &get_ancestors() const;
+
+    /**
+     * @brief Checks whether this type is assignable from the `t` type.
+     *
+     * The check is a constant-time lookup into the ancestors of `t`. The core encodes the ancestors of its types once the declarations read from riddle code have been refined. If the hierarchy has changed since (e.g., through types created programmatically), the first check encodes again the ancestors and the layouts of all the types of the core, allocating memory and mutating them, hence such a check must not run concurrently with other accesses to the types.
+     *
+     * @param t The type to check.
+     * @return true If this type is assignable from the `t` type.
+     * @return false If this type is not assignable from the `t` type.
+     */
+    RATIOCORE_EXPORT virtual bool is_assignable_from(const type &t) const;
+
+    RATIOCORE_EXPORT virtual expr new_instance();                                // creates a new instance of this type..
+    RATIOCORE_EXPORT virtual expr new_existential();                             // creates a new existential of this type (i.e. an object variable whose allowed values are all the current instances of this type)..
+    /**
+     * @brief Get a view of the current instances of this type and, transitively, of its subtypes.
+     *
+     * The view is not copied, hence it is invalidated (as are its iterators) by the creation of new instances of this type or of its subtypes. Callers which create instances while iterating, or which keep the instances, should take a snapshot through `get_domain` instead.
+     *
+     * @return const std::vector<expr>& A view of the current instances of this type.
+     */
+    const std::vector<expr> &get_instances() const noexcept { return instances; }
+    /**
+     * @brief Get an immutable snapshot of the current instances of this type.
+     *
+     * The snapshot is shared until new instances of this type are created, at which point the next call takes a new one.
+     *
+     * @return domain The snapshot of the current instances of this type.
+     */
+    RATIOCORE_EXPORT domain get_domain() const noexcept;
 
   protected:
+    RATIOCORE_EXPORT void new_field(field_ptr f) override;
     RATIOCORE_EXPORT void new_supertype(type &t) noexcept;
     RATIOCORE_EXPORT void new_constructor(constructor_ptr c) noexcept;
     RATIOCORE_EXPORT void new_method(method_ptr m) noexcept;
@@ -61,19 +91,57 @@ namespace ratio::core
     RATIOCORE_EXPORT void new_predicate(predicate_ptr p) noexcept;
 
   public:
-    RATIOCORE_EXPORT const field &get_field(const std::string &name) const override;
+    RATIOCORE_EXPORT const field *find_field(const std::string &name) const noexcept override;
+    /**
+     * @brief Find the field with the given symbol defined within this type or, transitively, within its supertypes.
+     *
+     * Unlike `find_field`, the enclosing scopes are not searched, and the lookup is a single probe into the layout of this type.
+     *
+     * @param sym The symbol of the desired field.
+     * @return const field* The field with the given symbol, or `nullptr` if there is no such field.
+     */
+    RATIOCORE_EXPORT const field *find_inherited_field(const symbol &sym) const noexcept;
+    /**
+     * @brief Get the current layout of the instances of this type, assigning a slot to each field defined within this type or, transitively, within its supertypes.
+     *
+     * @return const slot_layout& The current layout of the instances of this type.
+     */
+    RATIOCORE_EXPORT const slot_layout &get_layout() const;
+    /**
+     * @brief Find the constructor of this type whose parameters are assignable from the given types.
+     *
+     * @param ts The types of the arguments.
+     * @return constructor* The constructor of this type whose parameters are assignable from the given types, or `nullptr` if there is no such constructor.
+     */
+    RATIOCORE_EXPORT constructor *find_constructor(const std::vector<const type *> &ts) const noexcept;
+    /**
+     * @brief Get the constructor of this type whose parameters are assignable from the given types.
+     *
+     * @param ts The types of the arguments.
+     * @return constructor& The constructor of this type whose parameters are assignable from the given types.
+     * @throws std::out_of_range Thrown if there is no such constructor.
+     */
     RATIOCORE_EXPORT constructor &get_constructor(const std::vector<const type *> &ts) const;
     const std::vector<constructor_ptr> &get_constructors() const noexcept { return constructors; }
-    RATIOCORE_EXPORT method &get_method(const std::string &name, const std::vector<const type *> &ts) const override;
+    RATIOCORE_EXPORT method *find_method(const std::string &name, const std::vector<const type *> &ts) const noexcept override;
     const std::map<std::string, std::vector<method_ptr>> &get_methods() const noexcept override { return methods; }
-    RATIOCORE_EXPORT type &get_type(const std::string &name) const override;
+    RATIOCORE_EXPORT type *find_type(const std::string &name) const noexcept override;
     const std::map<std::string, type_ptr> &get_types() const noexcept override { return types; }
-    RATIOCORE_EXPORT predicate &get_predicate(const std::string &name) const override;
+    RATIOCORE_EXPORT predicate *find_predicate(const std::string &name) const noexcept override;
     const std::map<std::string, predicate_ptr> &get_predicates() const noexcept override { return predicates; }
 
+  private:
+    void add_ancestor(const type &t) noexcept;                 // makes the `t` type assignable from this type..
+    void encode_ancestors(std::vector<bool> &encoded);          // encodes the ancestors and the layout of this type, after having encoded those of its supertypes..
+
   private:
     const std::string name;
-    const bool primitive; // is this type a primitive type?
+    const bool primitive;                                    // is this type a primitive type?
+    const size_t id;                                         // the dense index of this type within its core..
+    std::vector<uint64_t> ancestors;                         // the bitset of the dense indexes of the types this type is assignable to (i.e., this type and, transitively, its supertypes)..
+    std::vector<type *> ancestor_types;                      // this type and, transitively, its supertypes, without duplicates..
+    std::vector<std::unique_ptr<const slot_layout>> layouts; // the layouts of the instances of this type, the last being the current one (the previous ones are kept for the instances created before the fields of this type changed)..
+    mutable domain c_domain;                                 // the last snapshot of the instances of this type..
 
   protected:
     std::vector<type *> supertypes;                         // the base types (i.e. the types this type inherits from)..
@@ -90,7 +158,6 @@ namespace ratio::core
     bool_type(core &cr);
     bool_type(const bool_type &that) = delete;
 
-    bool is_assignable_from(const type &t) const noexcept override { return &t == this; }
     expr new_instance() noexcept override;
   };
 
@@ -100,7 +167,6 @@ namespace ratio::core
     int_type(core &cr);
     int_type(const int_type &that) = delete;
 
-    bool is_assignable_from(const type &t) const noexcept override;
     expr new_instance() noexcept override;
   };
 
@@ -110,7 +176,6 @@ namespace ratio::core
     real_type(core &cr);
     real_type(const real_type &that) = delete;
 
-    bool is_assignable_from(const type &t) const noexcept override;
     expr new_instance() noexcept override;
   };
 
@@ -120,7 +185,6 @@ namespace ratio::core
     time_type(core &cr);
     time_type(const time_type &that) = delete;
 
-    bool is_assignable_from(const type &t) const noexcept override;
     expr new_instance() noexcept override;
   };
 
@@ -130,14 +194,15 @@ namespace ratio::core
     string_type(core &cr);
     string_type(const string_type &that) = delete;
 
-    bool is_assignable_from(const type &t) const noexcept override { return &t == this; }
     expr new_instance() noexcept override;
   };
 
   class typedef_type final : public type
   {
+    friend class typedef_declaration;
+
   public:
-    typedef_type(scope &scp, const std::string &name, const type &base_type, const std::unique_ptr<const riddle::ast::expression> &e);
+    typedef_type(scope &scp, const std::string &name, const type &base_type, const expression &e);
     typedef_type(const typedef_type &orig) = delete;
 
     const type &get_base_type() const noexcept { return base_type; }
@@ -146,7 +211,7 @@ namespace ratio::core
 
   private:
     const type &base_type;
-    const std::unique_ptr<const riddle::ast::expression> &xpr;
+    const expression *xpr; // the expression of the typedef, rebound when its declaration is reloaded..
   };
 
   class enum_type : public type
@@ -161,9 +226,11 @@ namespace ratio::core
     expr new_instance() override;
 
   private:
-    std::vector<expr> get_all_instances() const noexcept;
+    size_t count_all_instances() const noexcept; // returns the number of the instances of this enum and, transitively, of the referenced enums..
+    domain get_all_instances() const noexcept;   // returns a snapshot of the instances of this enum and, transitively, of the referenced enums..
 
   private:
     std::vector<enum_type *> enums;
+    mutable domain c_all_instances; // the last snapshot of the instances of this enum and, transitively, of the referenced enums..
   };
 } // namespace ratio::core
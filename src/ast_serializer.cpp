@@ -0,0 +1,798 @@
+#include "ast_serializer.h"
+#include "scope.h"
+#include "parser.h"
+#include <stdexcept>
+
+namespace ratio::core
+{
+    constexpr char RCU_MAGIC[] = {'R', 'C', 'U', '\0'};
+    constexpr uint64_t RCU_VERSION = 2; // to be incremented whenever the format, or the ast, changes..
+
+    RATIOCORE_EXPORT void ast_writer::write_header(std::string_view content)
+    {
+        os.write(RCU_MAGIC, sizeof(RCU_MAGIC));
+        write_uint(RCU_VERSION);
+        write_uint(content_hash(content));
+        write_uint(content.size());
+        os.write(content.data(), content.size());
+    }
+
+    RATIOCORE_EXPORT void ast_writer::write_kind(const ast_kind &k) { os.put(static_cast<char>(k)); }
+    RATIOCORE_EXPORT void ast_writer::write_bool(const bool &b) { os.put(b ? 1 : 0); }
+    RATIOCORE_EXPORT void ast_writer::write_uint(uint64_t n)
+    { // we write the number as a LEB128 varint..
+        while (n >= 0x80)
+        {
+            os.put(static_cast<char>((n & 0x7F) | 0x80));
+            n >>= 7;
+        }
+        os.put(static_cast<char>(n));
+    }
+    RATIOCORE_EXPORT void ast_writer::write_int(const int64_t &n) { write_uint((static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63)); } // zig-zag encoding..
+    RATIOCORE_EXPORT void ast_writer::write_string(const std::string &str)
+    {
+        write_uint(str.size());
+        os.write(str.data(), str.size());
+    }
+    RATIOCORE_EXPORT void ast_writer::write_rational(const semitone::rational &r)
+    {
+        write_int(r.numerator());
+        write_int(r.denominator());
+    }
+
+    void ast_writer::write_position(const riddle::token &tk)
+    {
+        if (!positions)
+            return;
+        write_uint(tk.start_line);
+        write_uint(tk.start_pos);
+        write_uint(tk.end_line);
+        write_uint(tk.end_pos);
+    }
+    RATIOCORE_EXPORT void ast_writer::write_id(const riddle::id_token &id)
+    {
+        write_position(id);
+        write_string(id.id);
+    }
+    RATIOCORE_EXPORT void ast_writer::write_ids(const std::vector<riddle::id_token> &ids)
+    {
+        write_uint(ids.size());
+        for (const auto &id : ids)
+            write_id(id);
+    }
+    RATIOCORE_EXPORT void ast_writer::write_paths(const std::vector<std::vector<riddle::id_token>> &paths)
+    {
+        write_uint(paths.size());
+        for (const auto &p : paths)
+            write_ids(p);
+    }
+    RATIOCORE_EXPORT void ast_writer::write_parameters(const std::vector<std::pair<const std::vector<riddle::id_token>, const riddle::id_token>> &pars)
+    {
+        write_uint(pars.size());
+        for (const auto &[tp, id] : pars)
+        {
+            write_ids(tp);
+            write_id(id);
+        }
+    }
+    RATIOCORE_EXPORT void ast_writer::write_bool_token(const riddle::bool_token &tk)
+    {
+        write_position(tk);
+        write_bool(tk.val);
+    }
+    RATIOCORE_EXPORT void ast_writer::write_int_token(const riddle::int_token &tk)
+    {
+        write_position(tk);
+        write_int(tk.val);
+    }
+    RATIOCORE_EXPORT void ast_writer::write_real_token(const riddle::real_token &tk)
+    {
+        write_position(tk);
+        write_rational(tk.val);
+    }
+    RATIOCORE_EXPORT void ast_writer::write_string_token(const riddle::string_token &tk)
+    {
+        write_position(tk);
+        write_string(tk.str);
+    }
+
+    RATIOCORE_EXPORT void ast_writer::write_expression(const std::unique_ptr<const riddle::ast::expression> &xpr)
+    {
+        if (xpr)
+            dynamic_cast<const ratio::core::expression &>(*xpr).write(*this);
+        else
+            write_kind(ast_kind::none);
+    }
+    RATIOCORE_EXPORT void ast_writer::write_expressions(const std::vector<std::unique_ptr<const riddle::ast::expression>> &xprs)
+    {
+        write_uint(xprs.size());
+        for (const auto &xpr : xprs)
+            write_expression(xpr);
+    }
+    RATIOCORE_EXPORT void ast_writer::write_statement(const std::unique_ptr<const riddle::ast::statement> &stmnt) { dynamic_cast<const ratio::core::statement &>(*stmnt).write(*this); }
+    RATIOCORE_EXPORT void ast_writer::write_statements(const std::vector<std::unique_ptr<const riddle::ast::statement>> &stmnts)
+    {
+        write_uint(stmnts.size());
+        for (const auto &stmnt : stmnts)
+            write_statement(stmnt);
+    }
+
+    void bool_literal_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::bool_literal_expression);
+        w.write_bool_token(literal);
+    }
+    void int_literal_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::int_literal_expression);
+        w.write_int_token(literal);
+    }
+    void real_literal_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::real_literal_expression);
+        w.write_real_token(literal);
+    }
+    void string_literal_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::string_literal_expression);
+        w.write_string_token(literal);
+    }
+    void cast_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::cast_expression);
+        w.write_ids(cast_to_type);
+        w.write_expression(xpr);
+    }
+    void plus_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::plus_expression);
+        w.write_expression(xpr);
+    }
+    void minus_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::minus_expression);
+        w.write_expression(xpr);
+    }
+    void not_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::not_expression);
+        w.write_expression(xpr);
+    }
+    void constructor_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::constructor_expression);
+        w.write_ids(instance_type);
+        w.write_expressions(expressions);
+    }
+    void eq_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::eq_expression);
+        w.write_expression(left);
+        w.write_expression(right);
+    }
+    void neq_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::neq_expression);
+        w.write_expression(left);
+        w.write_expression(right);
+    }
+    void lt_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::lt_expression);
+        w.write_expression(left);
+        w.write_expression(right);
+    }
+    void leq_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::leq_expression);
+        w.write_expression(left);
+        w.write_expression(right);
+    }
+    void geq_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::geq_expression);
+        w.write_expression(left);
+        w.write_expression(right);
+    }
+    void gt_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::gt_expression);
+        w.write_expression(left);
+        w.write_expression(right);
+    }
+    void function_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::function_expression);
+        w.write_ids(ids);
+        w.write_id(function_name);
+        w.write_expressions(expressions);
+    }
+    void id_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::id_expression);
+        w.write_ids(ids);
+    }
+    void implication_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::implication_expression);
+        w.write_expression(left);
+        w.write_expression(right);
+    }
+    void disjunction_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::disjunction_expression);
+        w.write_expressions(expressions);
+    }
+    void conjunction_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::conjunction_expression);
+        w.write_expressions(expressions);
+    }
+    void exct_one_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::exct_one_expression);
+        w.write_expressions(expressions);
+    }
+    void addition_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::addition_expression);
+        w.write_expressions(expressions);
+    }
+    void subtraction_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::subtraction_expression);
+        w.write_expressions(expressions);
+    }
+    void multiplication_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::multiplication_expression);
+        w.write_expressions(expressions);
+    }
+    void division_expression::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::division_expression);
+        w.write_expressions(expressions);
+    }
+
+    void local_field_statement::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::local_field_statement);
+        w.write_ids(field_type);
+        w.write_ids(names);
+        w.write_expressions(xprs);
+    }
+    void assignment_statement::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::assignment_statement);
+        w.write_ids(ids);
+        w.write_id(id);
+        w.write_expression(xpr);
+    }
+    void expression_statement::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::expression_statement);
+        w.write_expression(xpr);
+    }
+    void disjunction_statement::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::disjunction_statement);
+        w.write_uint(conjunctions.size());
+        for (const auto &conj : conjunctions)
+            w.write_statements(conj);
+        w.write_expressions(conjunction_costs);
+    }
+    void conjunction_statement::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::conjunction_statement);
+        w.write_statements(statements);
+    }
+    void formula_statement::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::formula_statement);
+        w.write_bool(is_fact);
+        w.write_id(formula_name);
+        w.write_ids(formula_scope);
+        w.write_id(predicate_name);
+        w.write_ids(assignment_names);
+        w.write_expressions(assignment_values);
+    }
+    void return_statement::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::return_statement);
+        w.write_expression(xpr);
+    }
+
+    void method_declaration::write(ast_writer &w) const
+    {
+        w.write_ids(return_type);
+        w.write_id(name);
+        w.write_parameters(parameters);
+        w.write_statements(statements);
+    }
+    void predicate_declaration::write(ast_writer &w) const
+    {
+        w.write_id(name);
+        w.write_parameters(parameters);
+        w.write_paths(predicate_list);
+        w.write_statements(statements);
+    }
+    void typedef_declaration::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::typedef_declaration);
+        w.write_id(name);
+        w.write_id(primitive_type);
+        w.write_expression(xpr);
+    }
+    void enum_declaration::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::enum_declaration);
+        w.write_id(name);
+        w.write_uint(enums.size());
+        for (const auto &e : enums)
+            w.write_string_token(e);
+        w.write_paths(type_refs);
+    }
+    void variable_declaration::write(ast_writer &w) const
+    {
+        w.write_id(name);
+        w.write_expression(xpr);
+    }
+    void field_declaration::write(ast_writer &w) const
+    {
+        w.write_ids(field_type);
+        w.write_uint(declarations.size());
+        for (const auto &vd : declarations)
+            static_cast<const variable_declaration &>(*vd).write(w);
+    }
+    void constructor_declaration::write(ast_writer &w) const
+    {
+        w.write_parameters(parameters);
+        w.write_ids(init_names);
+        w.write_uint(init_vals.size());
+        for (const auto &ivs : init_vals)
+            w.write_expressions(ivs);
+        w.write_statements(statements);
+    }
+    void class_declaration::write(ast_writer &w) const
+    {
+        w.write_kind(ast_kind::class_declaration);
+        w.write_id(name);
+        w.write_paths(base_classes);
+        w.write_uint(fields.size());
+        for (const auto &f : fields)
+            static_cast<const ratio::core::field_declaration &>(*f).write(w);
+        w.write_uint(constructors.size());
+        for (const auto &c : constructors)
+            static_cast<const ratio::core::constructor_declaration &>(*c).write(w);
+        w.write_uint(methods.size());
+        for (const auto &m : methods)
+            static_cast<const ratio::core::method_declaration &>(*m).write(w);
+        w.write_uint(predicates.size());
+        for (const auto &p : predicates)
+            static_cast<const ratio::core::predicate_declaration &>(*p).write(w);
+        w.write_uint(types.size());
+        for (const auto &t : types)
+            dynamic_cast<const ratio::core::type_declaration &>(*t).write(w);
+    }
+    void compilation_unit::write(ast_writer &w) const
+    {
+        w.write_uint(methods.size());
+        for (const auto &m : methods)
+            static_cast<const ratio::core::method_declaration &>(*m).write(w);
+        w.write_uint(predicates.size());
+        for (const auto &p : predicates)
+            static_cast<const ratio::core::predicate_declaration &>(*p).write(w);
+        w.write_uint(types.size());
+        for (const auto &t : types)
+            dynamic_cast<const ratio::core::type_declaration &>(*t).write(w);
+        w.write_statements(statements);
+    }
+
+    RATIOCORE_EXPORT bool ast_reader::read_header(std::string_view content)
+    {
+        if (data.substr(0, sizeof(RCU_MAGIC)) != std::string_view(RCU_MAGIC, sizeof(RCU_MAGIC)))
+            return false;
+        pos = sizeof(RCU_MAGIC);
+        if (read_uint() != RCU_VERSION || read_uint() != content_hash(content) || read_uint() != content.size())
+            return false;
+        if (data.substr(pos, content.size()) != content) // the hashes collide..
+            return false;
+        pos += content.size();
+        return true;
+    }
+
+    ast_kind ast_reader::read_kind()
+    {
+        if (pos >= data.size())
+            throw std::invalid_argument("unexpected end of compilation unit data..");
+        const auto k = static_cast<uint8_t>(data[pos++]);
+        if (k > static_cast<uint8_t>(ast_kind::class_declaration))
+            throw std::invalid_argument("invalid node kind in compilation unit data..");
+        return static_cast<ast_kind>(k);
+    }
+    bool ast_reader::read_bool()
+    {
+        if (pos >= data.size())
+            throw std::invalid_argument("unexpected end of compilation unit data..");
+        return data[pos++] != 0;
+    }
+    uint64_t ast_reader::read_uint()
+    {
+        uint64_t n = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            if (pos >= data.size())
+                throw std::invalid_argument("unexpected end of compilation unit data..");
+            const auto b = static_cast<uint8_t>(data[pos++]);
+            n |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80))
+                return n;
+        }
+        throw std::invalid_argument("invalid number in compilation unit data..");
+    }
+    int64_t ast_reader::read_int()
+    {
+        const auto n = read_uint();
+        return static_cast<int64_t>(n >> 1) ^ -static_cast<int64_t>(n & 1);
+    }
+    std::string ast_reader::read_string()
+    {
+        const auto size = read_uint();
+        if (size > data.size() - pos)
+            throw std::invalid_argument("unexpected end of compilation unit data..");
+        std::string str(data.substr(pos, size));
+        pos += size;
+        return str;
+    }
+    semitone::rational ast_reader::read_rational()
+    {
+        const auto num = read_int();
+        const auto den = read_int();
+        if (den == 0)
+            throw std::invalid_argument("invalid rational in compilation unit data..");
+        return semitone::rational(num, den);
+    }
+
+    ast_reader::position ast_reader::read_position()
+    {
+        position p;
+        p.start_line = read_uint();
+        p.start_pos = read_uint();
+        p.end_line = read_uint();
+        p.end_pos = read_uint();
+        return p;
+    }
+    riddle::id_token ast_reader::read_id()
+    {
+        const auto p = read_position();
+        return riddle::id_token(p.start_line, p.start_pos, p.end_line, p.end_pos, read_string());
+    }
+    std::vector<riddle::id_token> ast_reader::read_ids()
+    {
+        std::vector<riddle::id_token> ids;
+        const auto size = read_uint();
+        for (size_t i = 0; i < size; ++i)
+            ids.push_back(read_id());
+        return ids;
+    }
+    std::vector<std::vector<riddle::id_token>> ast_reader::read_paths()
+    {
+        std::vector<std::vector<riddle::id_token>> paths;
+        const auto size = read_uint();
+        for (size_t i = 0; i < size; ++i)
+            paths.push_back(read_ids());
+        return paths;
+    }
+    std::vector<std::pair<const std::vector<riddle::id_token>, const riddle::id_token>> ast_reader::read_parameters()
+    {
+        std::vector<std::pair<const std::vector<riddle::id_token>, const riddle::id_token>> pars;
+        const auto size = read_uint();
+        for (size_t i = 0; i < size; ++i)
+        {
+            auto tp = read_ids();
+            auto id = read_id();
+            pars.emplace_back(std::move(tp), std::move(id));
+        }
+        return pars;
+    }
+
+    std::unique_ptr<const riddle::ast::expression> ast_reader::read_expression()
+    {
+        switch (read_kind())
+        {
+        case ast_kind::none:
+            return nullptr;
+        case ast_kind::bool_literal_expression:
+        {
+            const auto p = read_position();
+            return std::unique_ptr<const riddle::ast::bool_literal_expression>(std::make_unique<const ratio::core::bool_literal_expression>(riddle::bool_token(p.start_line, p.start_pos, p.end_line, p.end_pos, read_bool())));
+        }
+        case ast_kind::int_literal_expression:
+        {
+            const auto p = read_position();
+            return std::unique_ptr<const riddle::ast::int_literal_expression>(std::make_unique<const ratio::core::int_literal_expression>(riddle::int_token(p.start_line, p.start_pos, p.end_line, p.end_pos, read_int())));
+        }
+        case ast_kind::real_literal_expression:
+        {
+            const auto p = read_position();
+            return std::unique_ptr<const riddle::ast::real_literal_expression>(std::make_unique<const ratio::core::real_literal_expression>(riddle::real_token(p.start_line, p.start_pos, p.end_line, p.end_pos, read_rational())));
+        }
+        case ast_kind::string_literal_expression:
+        {
+            const auto p = read_position();
+            return std::unique_ptr<const riddle::ast::string_literal_expression>(std::make_unique<const ratio::core::string_literal_expression>(riddle::string_token(p.start_line, p.start_pos, p.end_line, p.end_pos, read_string())));
+        }
+        case ast_kind::cast_expression:
+        {
+            auto tp = read_ids();
+            auto xpr = read_expression();
+            return std::unique_ptr<const riddle::ast::cast_expression>(std::make_unique<const ratio::core::cast_expression>(tp, std::move(xpr)));
+        }
+        case ast_kind::plus_expression:
+            return std::unique_ptr<const riddle::ast::plus_expression>(std::make_unique<const ratio::core::plus_expression>(read_expression()));
+        case ast_kind::minus_expression:
+            return std::unique_ptr<const riddle::ast::minus_expression>(std::make_unique<const ratio::core::minus_expression>(read_expression()));
+        case ast_kind::not_expression:
+            return std::unique_ptr<const riddle::ast::not_expression>(std::make_unique<const ratio::core::not_expression>(read_expression()));
+        case ast_kind::constructor_expression:
+        {
+            auto it = read_ids();
+            auto es = read_expressions();
+            return std::unique_ptr<const riddle::ast::constructor_expression>(std::make_unique<const ratio::core::constructor_expression>(std::move(it), std::move(es)));
+        }
+        case ast_kind::eq_expression:
+        {
+            auto l = read_expression();
+            auto r = read_expression();
+            return std::unique_ptr<const riddle::ast::eq_expression>(std::make_unique<const ratio::core::eq_expression>(std::move(l), std::move(r)));
+        }
+        case ast_kind::neq_expression:
+        {
+            auto l = read_expression();
+            auto r = read_expression();
+            return std::unique_ptr<const riddle::ast::neq_expression>(std::make_unique<const ratio::core::neq_expression>(std::move(l), std::move(r)));
+        }
+        case ast_kind::lt_expression:
+        {
+            auto l = read_expression();
+            auto r = read_expression();
+            return std::unique_ptr<const riddle::ast::lt_expression>(std::make_unique<const ratio::core::lt_expression>(std::move(l), std::move(r)));
+        }
+        case ast_kind::leq_expression:
+        {
+            auto l = read_expression();
+            auto r = read_expression();
+            return std::unique_ptr<const riddle::ast::leq_expression>(std::make_unique<const ratio::core::leq_expression>(std::move(l), std::move(r)));
+        }
+        case ast_kind::geq_expression:
+        {
+            auto l = read_expression();
+            auto r = read_expression();
+            return std::unique_ptr<const riddle::ast::geq_expression>(std::make_unique<const ratio::core::geq_expression>(std::move(l), std::move(r)));
+        }
+        case ast_kind::gt_expression:
+        {
+            auto l = read_expression();
+            auto r = read_expression();
+            return std::unique_ptr<const riddle::ast::gt_expression>(std::make_unique<const ratio::core::gt_expression>(std::move(l), std::move(r)));
+        }
+        case ast_kind::function_expression:
+        {
+            auto is = read_ids();
+            auto fn = read_id();
+            auto es = read_expressions();
+            return std::unique_ptr<const riddle::ast::function_expression>(std::make_unique<const ratio::core::function_expression>(std::move(is), fn, std::move(es)));
+        }
+        case ast_kind::id_expression:
+            return std::unique_ptr<const riddle::ast::id_expression>(std::make_unique<const ratio::core::id_expression>(read_ids()));
+        case ast_kind::implication_expression:
+        {
+            auto l = read_expression();
+            auto r = read_expression();
+            return std::unique_ptr<const riddle::ast::implication_expression>(std::make_unique<const ratio::core::implication_expression>(std::move(l), std::move(r)));
+        }
+        case ast_kind::disjunction_expression:
+            return std::unique_ptr<const riddle::ast::disjunction_expression>(std::make_unique<const ratio::core::disjunction_expression>(read_expressions()));
+        case ast_kind::conjunction_expression:
+            return std::unique_ptr<const riddle::ast::conjunction_expression>(std::make_unique<const ratio::core::conjunction_expression>(read_expressions()));
+        case ast_kind::exct_one_expression:
+            return std::unique_ptr<const riddle::ast::exct_one_expression>(std::make_unique<const ratio::core::exct_one_expression>(read_expressions()));
+        case ast_kind::addition_expression:
+            return std::unique_ptr<const riddle::ast::addition_expression>(std::make_unique<const ratio::core::addition_expression>(read_expressions()));
+        case ast_kind::subtraction_expression:
+            return std::unique_ptr<const riddle::ast::subtraction_expression>(std::make_unique<const ratio::core::subtraction_expression>(read_expressions()));
+        case ast_kind::multiplication_expression:
+            return std::unique_ptr<const riddle::ast::multiplication_expression>(std::make_unique<const ratio::core::multiplication_expression>(read_expressions()));
+        case ast_kind::division_expression:
+            return std::unique_ptr<const riddle::ast::division_expression>(std::make_unique<const ratio::core::division_expression>(read_expressions()));
+        default:
+            throw std::invalid_argument("expected an expression in compilation unit data..");
+        }
+    }
+    std::vector<std::unique_ptr<const riddle::ast::expression>> ast_reader::read_expressions()
+    {
+        std::vector<std::unique_ptr<const riddle::ast::expression>> xprs;
+        const auto size = read_uint();
+        for (size_t i = 0; i < size; ++i)
+            xprs.emplace_back(read_expression());
+        return xprs;
+    }
+
+    std::unique_ptr<const riddle::ast::statement> ast_reader::read_statement()
+    {
+        switch (read_kind())
+        {
+        case ast_kind::local_field_statement:
+        {
+            auto ft = read_ids();
+            auto ns = read_ids();
+            auto es = read_expressions();
+            return std::unique_ptr<const riddle::ast::local_field_statement>(std::make_unique<const ratio::core::local_field_statement>(std::move(ft), std::move(ns), std::move(es)));
+        }
+        case ast_kind::assignment_statement:
+        {
+            auto is = read_ids();
+            auto i = read_id();
+            auto e = read_expression();
+            return std::unique_ptr<const riddle::ast::assignment_statement>(std::make_unique<const ratio::core::assignment_statement>(std::move(is), i, std::move(e)));
+        }
+        case ast_kind::expression_statement:
+            return std::unique_ptr<const riddle::ast::expression_statement>(std::make_unique<const ratio::core::expression_statement>(read_expression()));
+        case ast_kind::disjunction_statement:
+        {
+            std::vector<std::vector<std::unique_ptr<const riddle::ast::statement>>> conjs;
+            const auto size = read_uint();
+            for (size_t i = 0; i < size; ++i)
+                conjs.emplace_back(read_statements());
+            auto conj_costs = read_expressions();
+            return std::unique_ptr<const riddle::ast::disjunction_statement>(std::make_unique<const ratio::core::disjunction_statement>(std::move(conjs), std::move(conj_costs)));
+        }
+        case ast_kind::conjunction_statement:
+            return std::unique_ptr<const riddle::ast::conjunction_statement>(std::make_unique<const ratio::core::conjunction_statement>(read_statements()));
+        case ast_kind::formula_statement:
+        {
+            const bool isf = read_bool();
+            auto fn = read_id();
+            auto scp = read_ids();
+            auto pn = read_id();
+            auto assn_ns = read_ids();
+            auto assn_vs = read_expressions();
+            return std::unique_ptr<const riddle::ast::formula_statement>(std::make_unique<const ratio::core::formula_statement>(isf, fn, std::move(scp), pn, std::move(assn_ns), std::move(assn_vs)));
+        }
+        case ast_kind::return_statement:
+            return std::unique_ptr<const riddle::ast::return_statement>(std::make_unique<const ratio::core::return_statement>(read_expression()));
+        default:
+            throw std::invalid_argument("expected a statement in compilation unit data..");
+        }
+    }
+    std::vector<std::unique_ptr<const riddle::ast::statement>> ast_reader::read_statements()
+    {
+        std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts;
+        const auto size = read_uint();
+        for (size_t i = 0; i < size; ++i)
+            stmnts.emplace_back(read_statement());
+        return stmnts;
+    }
+
+    std::unique_ptr<const riddle::ast::method_declaration> ast_reader::read_method_declaration()
+    {
+        auto rt = read_ids();
+        auto n = read_id();
+        auto pars = read_parameters();
+        auto stmnts = read_statements();
+        return std::make_unique<const ratio::core::method_declaration>(std::move(rt), n, std::move(pars), std::move(stmnts));
+    }
+    std::unique_ptr<const riddle::ast::predicate_declaration> ast_reader::read_predicate_declaration()
+    {
+        auto n = read_id();
+        auto pars = read_parameters();
+        auto pl = read_paths();
+        auto stmnts = read_statements();
+        return std::make_unique<const ratio::core::predicate_declaration>(n, std::move(pars), std::move(pl), std::move(stmnts));
+    }
+    std::unique_ptr<const riddle::ast::field_declaration> ast_reader::read_field_declaration()
+    {
+        auto tp = read_ids();
+        std::vector<std::unique_ptr<const riddle::ast::variable_declaration>> ds;
+        const auto size = read_uint();
+        for (size_t i = 0; i < size; ++i)
+        {
+            auto n = read_id();
+            auto e = read_expression();
+            ds.emplace_back(std::make_unique<const ratio::core::variable_declaration>(n, std::move(e)));
+        }
+        return std::make_unique<const ratio::core::field_declaration>(std::move(tp), std::move(ds));
+    }
+    std::unique_ptr<const riddle::ast::constructor_declaration> ast_reader::read_constructor_declaration()
+    {
+        auto pars = read_parameters();
+        auto ins = read_ids();
+        std::vector<std::vector<std::unique_ptr<const riddle::ast::expression>>> ivs;
+        const auto size = read_uint();
+        for (size_t i = 0; i < size; ++i)
+            ivs.emplace_back(read_expressions());
+        auto stmnts = read_statements();
+        return std::make_unique<const ratio::core::constructor_declaration>(std::move(pars), std::move(ins), std::move(ivs), std::move(stmnts));
+    }
+    std::unique_ptr<const riddle::ast::type_declaration> ast_reader::read_type_declaration()
+    {
+        switch (read_kind())
+        {
+        case ast_kind::typedef_declaration:
+        {
+            auto n = read_id();
+            auto pt = read_id();
+            auto e = read_expression();
+            return std::unique_ptr<const riddle::ast::typedef_declaration>(std::make_unique<const ratio::core::typedef_declaration>(n, pt, std::move(e)));
+        }
+        case ast_kind::enum_declaration:
+        {
+            auto n = read_id();
+            std::vector<riddle::string_token> es;
+            const auto size = read_uint();
+            for (size_t i = 0; i < size; ++i)
+            {
+                const auto p = read_position();
+                es.push_back(riddle::string_token(p.start_line, p.start_pos, p.end_line, p.end_pos, read_string()));
+            }
+            auto trs = read_paths();
+            return std::unique_ptr<const riddle::ast::enum_declaration>(std::make_unique<const ratio::core::enum_declaration>(n, std::move(es), std::move(trs)));
+        }
+        case ast_kind::class_declaration:
+        {
+            auto n = read_id();
+            auto bcs = read_paths();
+            std::vector<std::unique_ptr<const riddle::ast::field_declaration>> fs;
+            for (size_t i = 0, size = read_uint(); i < size; ++i)
+                fs.emplace_back(read_field_declaration());
+            std::vector<std::unique_ptr<const riddle::ast::constructor_declaration>> cs;
+            for (size_t i = 0, size = read_uint(); i < size; ++i)
+                cs.emplace_back(read_constructor_declaration());
+            std::vector<std::unique_ptr<const riddle::ast::method_declaration>> ms;
+            for (size_t i = 0, size = read_uint(); i < size; ++i)
+                ms.emplace_back(read_method_declaration());
+            std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> ps;
+            for (size_t i = 0, size = read_uint(); i < size; ++i)
+                ps.emplace_back(read_predicate_declaration());
+            std::vector<std::unique_ptr<const riddle::ast::type_declaration>> ts;
+            for (size_t i = 0, size = read_uint(); i < size; ++i)
+                ts.emplace_back(read_type_declaration());
+            return std::unique_ptr<const riddle::ast::class_declaration>(std::make_unique<const ratio::core::class_declaration>(n, std::move(bcs), std::move(fs), std::move(cs), std::move(ms), std::move(ps), std::move(ts)));
+        }
+        default:
+            throw std::invalid_argument("expected a type declaration in compilation unit data..");
+        }
+    }
+
+    RATIOCORE_EXPORT std::unique_ptr<const riddle::ast::compilation_unit> ast_reader::read_compilation_unit()
+    {
+        std::vector<std::unique_ptr<const riddle::ast::method_declaration>> ms;
+        for (size_t i = 0, size = read_uint(); i < size; ++i)
+            ms.emplace_back(read_method_declaration());
+        std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> ps;
+        for (size_t i = 0, size = read_uint(); i < size; ++i)
+            ps.emplace_back(read_predicate_declaration());
+        std::vector<std::unique_ptr<const riddle::ast::type_declaration>> ts;
+        for (size_t i = 0, size = read_uint(); i < size; ++i)
+            ts.emplace_back(read_type_declaration());
+        auto stmnts = read_statements();
+        if (pos != data.size())
+            throw std::invalid_argument("unexpected trailing compilation unit data..");
+        return std::make_unique<const ratio::core::compilation_unit>(std::move(ms), std::move(ps), std::move(ts), std::move(stmnts));
+    }
+
+    RATIOCORE_EXPORT void write_compilation_unit(std::ostream &os, std::string_view content, const riddle::ast::compilation_unit &cu)
+    {
+        ast_writer w(os);
+        w.write_header(content);
+        static_cast<const ratio::core::compilation_unit &>(cu).write(w);
+    }
+
+    RATIOCORE_EXPORT std::unique_ptr<const riddle::ast::compilation_unit> read_compilation_unit(std::string_view data, std::string_view content)
+    {
+        ast_reader r(data);
+        if (!r.read_header(content))
+            return nullptr;
+        return r.read_compilation_unit();
+    }
+} // namespace ratio::core
@@ -1,17 +1,18 @@
 #include "conjunction.h"
 #include "type.h"
 #include "env.h"
-#include "parser.h"
+#include "core.h"
 
 namespace ratio::core
 {
-    conjunction::conjunction(scope &scp, context ctx, semitone::rational cst, const std::vector<std::unique_ptr<const riddle::ast::statement>> &stmnts) : scope(scp), ctx(ctx), cost(std::move(cst)), statements(stmnts) {}
+    conjunction::conjunction(scope &scp, context ctx, semitone::rational cst, const program &body) : scope(scp), ctx(ctx), cost(std::move(cst)), body(body) {}
     conjunction::~conjunction() {}
 
     RATIOCORE_EXPORT void conjunction::execute()
     {
         context c_ctx(ctx);
-        for (const auto &s : statements)
-            dynamic_cast<const statement &>(*s).execute(*this, c_ctx);
+        fact_batch batch(get_core());
+        body.run(*this, c_ctx);
+        batch.flush();
     }
 } // namespace ratio::core
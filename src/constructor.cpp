@@ -1,4 +1,5 @@
 #include "constructor.h"
+#include "core.h"
 #include "type.h"
 #include "item.h"
 #include "field.h"
@@ -8,7 +9,7 @@
 
 namespace ratio::core
 {
-    constructor::constructor(type &tp, std::vector<field_ptr> args, const std::vector<riddle::id_token> &ins, const std::vector<std::vector<std::unique_ptr<const riddle::ast::expression>>> &ivs, const std::vector<std::unique_ptr<const riddle::ast::statement>> &stmnts) : scope(tp), init_names(ins), init_vals(ivs), statements(stmnts)
+    constructor::constructor(type &tp, std::vector<field_ptr> args, const std::vector<symbol> &ins, const std::vector<std::vector<const expression *>> &ivs, const std::vector<const statement *> &stmnts) : scope(tp), init_names(&ins), init_vals(&ivs), statements(&stmnts), init_caches(ins.size())
     {
         this->args.reserve(args.size());
         for (auto &f : args)
@@ -33,71 +34,68 @@ namespace ratio::core
 
     void constructor::invoke(complex_item &itm, std::vector<expr> exprs)
     {
-        auto ctx = std::make_shared<env>(itm);
-        ctx->vars.emplace(THIS_KW, expr(&itm));
+        frame frm(itm);
+        auto ctx = frm.get_context();
+        ctx->set(this_sym, borrow(itm));
         for (size_t i = 0; i < args.size(); ++i)
-            ctx->vars.emplace(args.at(i)->get_name(), exprs.at(i));
+            ctx->set(args.at(i)->get_symbol(), exprs.at(i));
 
-        for (size_t il_idx = 0; il_idx < init_names.size(); il_idx++)
-            try
-            { // we try to find the field in the current type..
-                const auto &f = get_field(init_names.at(il_idx).id);
-                if (f.get_type().is_primitive())
+        for (size_t il_idx = 0; il_idx < init_names->size(); il_idx++)
+            if (const field *f = find_field(init_names->at(il_idx).str()))
+            { // we have found the field in the current type..
+                if (f->get_type().is_primitive())
                 { // we evaluate the expression..
-                    assert(init_vals[il_idx].size() == 1);
-                    itm.vars.emplace(init_names[il_idx].id, dynamic_cast<const expression &>(*init_vals[il_idx][0]).evaluate(*this, ctx));
+                    assert((*init_vals)[il_idx].size() == 1);
+                    itm.set_var((*init_names)[il_idx], (*init_vals)[il_idx][0]->evaluate(*this, ctx));
                 }
                 else
                 { // we call the constructor..
                     std::vector<expr> c_exprs;
-                    std::vector<const type *> par_types;
-                    for (const auto &ex : init_vals.at(il_idx))
-                    {
-                        expr c_expr = dynamic_cast<const expression &>(*ex).evaluate(*this, ctx);
-                        c_exprs.push_back(c_expr);
-                        par_types.push_back(&c_expr->get_type());
-                    }
+                    for (const auto &ex : init_vals->at(il_idx))
+                        c_exprs.push_back(ex->evaluate(*this, ctx));
 
                     // we assume that the constructor exists..
-                    itm.vars.emplace(init_names[il_idx].id, f.get_type().get_constructor(par_types).new_instance(std::move(c_exprs)));
+                    constructor &c = init_caches[il_idx].get(get_core().cc_stats, c_exprs, [f](const std::vector<const type *> &par_types) -> constructor &
+                                                             { return f->get_type().get_constructor(par_types); });
+                    itm.set_var((*init_names)[il_idx], c.new_instance(std::move(c_exprs)));
                 }
             }
-            catch (const std::out_of_range &e)
+            else
             { // there is no field in the current type with the given name, so we call the supertype's constructor..
                 auto st = std::find_if(static_cast<type &>(get_scope()).get_supertypes().begin(), static_cast<type &>(get_scope()).get_supertypes().end(), [this, il_idx](auto &st)
-                                       { return init_names.at(il_idx).id == st->get_name(); });
+                                       { return init_names->at(il_idx).str() == st->get_name(); });
                 assert(*st);
                 std::vector<expr> c_exprs;
-                std::vector<const type *> par_types;
-                for (const auto &ex : init_vals.at(il_idx))
-                {
-                    expr c_expr = dynamic_cast<const expression &>(*ex).evaluate(*this, ctx);
-                    c_exprs.push_back(c_expr);
-                    par_types.push_back(&c_expr->get_type());
-                }
+                for (const auto &ex : init_vals->at(il_idx))
+                    c_exprs.push_back(ex->evaluate(*this, ctx));
 
                 // we assume that the constructor exists..
-                (*st)->get_constructor(par_types).invoke(itm, std::move(c_exprs));
+                constructor &c = init_caches[il_idx].get(get_core().cc_stats, c_exprs, [&st](const std::vector<const type *> &par_types) -> constructor &
+                                                         { return (*st)->get_constructor(par_types); });
+                c.invoke(itm, std::move(c_exprs));
             }
 
         // we instantiate the uninstantiated fields..
         for (const auto &[f_name, f] : get_scope().get_fields())
-            if (!f->is_synthetic() && !itm.vars.count(f_name))
+            if (!f->is_synthetic() && !itm.find_var(f->get_symbol()))
             { // the field is uninstantiated..
                 if (f->get_expression())
-                    itm.vars.emplace(f_name, dynamic_cast<const expression &>(*f->get_expression()).evaluate(*this, ctx));
+                    itm.set_var(f->get_symbol(), f->get_expression()->evaluate(*this, ctx));
                 else
                 {
                     type &tp = f->get_type();
                     if (tp.is_primitive())
-                        itm.vars.emplace(f_name, tp.new_instance());
+                        itm.set_var(f->get_symbol(), tp.new_instance());
                     else
-                        itm.vars.emplace(f_name, tp.new_existential());
+                        itm.set_var(f->get_symbol(), tp.new_existential());
                 }
             }
 
         // finally, we execute the constructor body..
-        for (const auto &s : statements)
-            dynamic_cast<const statement &>(*s).execute(*this, ctx);
+        if (body)
+            body->run(*this, ctx);
+        else
+            for (const auto &s : *statements)
+                s->execute(*this, ctx);
     }
 } // namespace ratio::core
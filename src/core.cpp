@@ -5,15 +5,27 @@
 #include "field.h"
 #include "atom.h"
 #include "parser.h"
+#include "memory_buffer.h"
+#include "mapped_file.h"
+#include "ast_serializer.h"
 #ifdef BUILD_LISTENERS
 #include "core_listener.h"
 #endif
 #ifdef COMPUTE_NAMES
 #include <queue>
 #endif
+#include <istream>
 #include <sstream>
 #include <fstream>
+#include <iomanip>
+#include <cstdio>
 #include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <atomic>
+#include <thread>
+#include <random>
+#include <queue>
 
 namespace ratio::core
 {
@@ -38,18 +50,53 @@ namespace ratio::core
         auto c_st = std::make_unique<string_type>(*this);
         st = c_st.get();
         new_type(std::move(c_st));
+
+        true_itm = new_item<bool_item>(*bt, semitone::TRUE_lit);
+        false_itm = new_item<bool_item>(*bt, semitone::FALSE_lit);
+    }
+    RATIOCORE_EXPORT core::~core()
+    {
+        vars = symbol_map<expr>(); // the variables are held by a base, which would otherwise be destroyed after the pool..
     }
-    RATIOCORE_EXPORT core::~core() {}
 
-    RATIOCORE_EXPORT void core::read(const std::string &script)
+    RATIOCORE_EXPORT void core::read(const std::string &script) { read_script(script); }
+    RATIOCORE_EXPORT void core::read(std::string_view script) { read_script(script); }
+
+    void core::read_script(std::string_view script)
     {
-        std::stringstream ss(script);
-        parser prs(ss);
-        auto cu = prs.parse();
+        timings = read_timings();
+        if (streaming)
+        {
+            context c_ctx(this);
+            stream(script, c_ctx);
+            RECOMPUTE_NAMES();
+            FIRE_READ(script);
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto cu = parse(script);
+        auto end = std::chrono::steady_clock::now();
+        timings.parsing = end - start;
+
+        start = end;
         static_cast<const ratio::core::compilation_unit &>(*cu).declare(*this);
+        end = std::chrono::steady_clock::now();
+        timings.declaring = end - start;
+
+        start = end;
         static_cast<const ratio::core::compilation_unit &>(*cu).refine(*this);
+        if (hierarchy_changed) // the declarations are complete, hence no subtype check will encode them..
+            encode_hierarchy();
+        static_cast<const ratio::core::compilation_unit &>(*cu).link(*this);
+        end = std::chrono::steady_clock::now();
+        timings.refining = end - start;
+
+        start = end;
         context c_ctx(this);
         static_cast<const ratio::core::compilation_unit &>(*cu).execute(*this, c_ctx);
+        timings.executing = std::chrono::steady_clock::now() - start;
+
         cus.emplace_back(std::move(cu));
         RECOMPUTE_NAMES();
         FIRE_READ(script);
@@ -57,38 +104,346 @@ namespace ratio::core
 
     RATIOCORE_EXPORT void core::read(const std::vector<std::string> &files)
     {
-        std::vector<std::unique_ptr<const riddle::ast::compilation_unit>> c_cus;
-        for (const auto &f : files)
-            if (std::ifstream ifs(f); ifs)
+        timings = read_timings();
+        if (streaming)
+        { // the files are read one after the other, so that each file can refer to the declarations of the previous ones..
+            context c_ctx(this);
+            for (const auto &file : files)
             {
-                parser prs(ifs);
-                auto cu = prs.parse();
-                cus.emplace_back(std::move(cu));
+                mapped_file mf(file);
+                stream(mf.get_content(), c_ctx);
             }
-            else
-                throw std::invalid_argument("cannot find file '" + f + "'");
+            RECOMPUTE_NAMES();
+            FIRE_READ(files);
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::unique_ptr<const riddle::ast::compilation_unit>> c_cus(files.size());
+        std::vector<std::exception_ptr> errors(files.size());
+        std::atomic<size_t> next_file(0);
+        // each worker parses the next unparsed file, storing the resulting compilation unit at the file's position so as to preserve the order of the files..
+        auto parse_files = [this, &files, &c_cus, &errors, &next_file]()
+        {
+            for (size_t i = next_file++; i < files.size(); i = next_file++)
+                try
+                {
+                    mapped_file mf(files[i]);
+                    c_cus[i] = parse(mf.get_content());
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+        };
 
+        size_t n_threads = parse_threads ? parse_threads : std::max(std::thread::hardware_concurrency(), 1u);
+        n_threads = std::min(n_threads, files.size());
+        if (n_threads > 1)
+        {
+            std::vector<std::thread> workers;
+            workers.reserve(n_threads - 1);
+            for (size_t i = 1; i < n_threads; ++i)
+                workers.emplace_back(parse_files);
+            parse_files(); // the calling thread parses as well..
+            for (auto &w : workers)
+                w.join();
+        }
+        else
+            parse_files();
+
+        // we report the error of the first file, in the given order, which could not be parsed..
+        for (const auto &err : errors)
+            if (err)
+                std::rethrow_exception(err);
+        auto end = std::chrono::steady_clock::now();
+        timings.parsing = end - start;
+
+        start = end;
         for (const auto &cu : c_cus)
             static_cast<const ratio::core::compilation_unit &>(*cu).declare(*this);
+        end = std::chrono::steady_clock::now();
+        timings.declaring = end - start;
+
+        start = end;
         for (const auto &cu : c_cus)
             static_cast<const ratio::core::compilation_unit &>(*cu).refine(*this);
+        if (hierarchy_changed) // the declarations are complete, hence no subtype check will encode them..
+            encode_hierarchy();
+        for (const auto &cu : c_cus)
+            static_cast<const ratio::core::compilation_unit &>(*cu).link(*this);
+        end = std::chrono::steady_clock::now();
+        timings.refining = end - start;
+
+        start = end;
         context c_ctx(this);
         for (const auto &cu : c_cus)
             static_cast<const ratio::core::compilation_unit &>(*cu).execute(*this, c_ctx);
+        timings.executing = std::chrono::steady_clock::now() - start;
+
         cus.reserve(cus.size() + c_cus.size());
-        for (auto &cu : c_cus)
-            cus.emplace_back(std::move(cu));
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            file_cus[files[i]] = c_cus[i].get();
+            cus.emplace_back(std::move(c_cus[i]));
+        }
         RECOMPUTE_NAMES();
         FIRE_READ(files);
     }
 
-    RATIOCORE_EXPORT expr core::new_bool(const bool &val) noexcept { return std::make_shared<bool_item>(get_bool_type(), val ? semitone::TRUE_lit : semitone::FALSE_lit); }
-    RATIOCORE_EXPORT expr core::new_int(const semitone::I &val) noexcept { return std::make_shared<arith_item>(get_int_type(), semitone::lin(semitone::rational(val))); }
-    RATIOCORE_EXPORT expr core::new_real(const semitone::rational &val) noexcept { return std::make_shared<arith_item>(get_real_type(), semitone::lin(val)); }
-    RATIOCORE_EXPORT expr core::new_time_point(const semitone::rational &val) noexcept { return std::make_shared<arith_item>(get_time_type(), semitone::lin(val)); }
-    RATIOCORE_EXPORT expr core::new_string(const std::string &val) noexcept { return std::make_shared<string_item>(get_string_type(), val); }
+    RATIOCORE_EXPORT bool core::reload(const std::string &file)
+    {
+        const auto at_f = file_cus.find(file);
+        if (at_f == file_cus.cend())
+            throw std::invalid_argument("file '" + file + "' has not been read");
+
+        mapped_file mf(file);
+        auto cu = parse(mf.get_content());
+        const auto &c_cu = static_cast<const ratio::core::compilation_unit &>(*cu);
+        const auto &old_cu = static_cast<const ratio::core::compilation_unit &>(*at_f->second);
+        if (!c_cu.is_reloadable(old_cu))
+            return false;
+
+        context c_ctx(this);
+        c_cu.reload(*this, c_ctx, old_cu);
+
+        if (!old_cu.retains_nodes()) // the existing items do not refer to the nodes of the old compilation unit, which can be released..
+            cus.erase(std::find_if(cus.cbegin(), cus.cend(), [&old_cu](const auto &c)
+                                   { return c.get() == &old_cu; }));
+        at_f->second = cu.get();
+        cus.emplace_back(std::move(cu));
+        RECOMPUTE_NAMES();
+        FIRE_READ(std::vector<std::string>({file}));
+        return true;
+    }
+
+    bool is_id_char(const char &c) noexcept { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }
 
-    RATIOCORE_EXPORT expr core::get(const std::string &name) noexcept
+    /**
+     * Returns the position of the first character, starting from `pos`, which is neither a whitespace nor part of a comment.
+     */
+    size_t skip_blanks(std::string_view script, size_t pos) noexcept
+    {
+        while (pos < script.size())
+            if (std::isspace(static_cast<unsigned char>(script[pos])))
+                ++pos;
+            else if (script.compare(pos, 2, "//") == 0)
+                pos = std::min(script.find('\n', pos), script.size());
+            else if (script.compare(pos, 2, "/*") == 0)
+                pos = std::min(script.find("*/", pos + 2), script.size() - 2) + 2;
+            else
+                break;
+        return pos;
+    }
+
+    /**
+     * Returns the next top-level declaration or statement of the script, starting from `pos`, advancing `pos` past it.
+     */
+    std::string_view next_chunk(std::string_view script, size_t &pos) noexcept
+    {
+        const size_t start = skip_blanks(script, pos);
+        size_t depth = 0;
+        size_t i = start;
+        while (i < script.size())
+            switch (script[i])
+            {
+            case '"': // we skip the string literal..
+                for (++i; i < script.size() && script[i] != '"'; ++i)
+                    if (script[i] == '\\')
+                        ++i;
+                ++i;
+                break;
+            case '/':
+                if (const auto j = skip_blanks(script, i); j != i)
+                    i = j;
+                else
+                    ++i;
+                break;
+            case '{':
+                ++depth;
+                ++i;
+                break;
+            case '}':
+                if (depth && --depth == 0)
+                { // a top-level block ends here, unless followed by another disjunct, a cost, an enum union or a semicolon..
+                    const auto j = skip_blanks(script, i + 1);
+                    if (j < script.size() && (script[j] == '[' || script[j] == '|' || script[j] == ';' || (script.compare(j, 2, "or") == 0 && !(j + 2 < script.size() && is_id_char(script[j + 2])))))
+                    {
+                        i = j;
+                        break;
+                    }
+                    pos = i + 1;
+                    return script.substr(start, pos - start);
+                }
+                ++i;
+                break;
+            case ';':
+                if (!depth)
+                {
+                    pos = i + 1;
+                    return script.substr(start, pos - start);
+                }
+                ++i;
+                break;
+            default:
+                ++i;
+            }
+        pos = script.size();
+        return script.substr(start, pos - start);
+    }
+
+    /**
+     * Checks whether the given chunk is a type or predicate declaration, hence whether it is worth caching.
+     */
+    bool is_declaration(std::string_view chunk) noexcept
+    {
+        size_t end = 0;
+        while (end < chunk.size() && is_id_char(chunk[end]))
+            ++end;
+        const auto kw = chunk.substr(0, end);
+        return kw == "class" || kw == "predicate" || kw == "typedef" || kw == "enum";
+    }
+
+    /**
+     * Parses the given riddle code in place, bypassing the cache.
+     */
+    std::unique_ptr<const riddle::ast::compilation_unit> parse_in_place(std::string_view content)
+    {
+        memory_buffer buf(content);
+        std::istream is(&buf);
+        parser prs(is);
+        return prs.parse();
+    }
+
+    void core::stream(std::string_view content, context &ctx)
+    {
+        std::vector<std::unique_ptr<const riddle::ast::compilation_unit>> c_cus; // the pending declarations..
+        auto flush = [this, &c_cus]()
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (const auto &cu : c_cus)
+                static_cast<const ratio::core::compilation_unit &>(*cu).declare(*this);
+            auto end = std::chrono::steady_clock::now();
+            timings.declaring += end - start;
+
+            start = end;
+            for (const auto &cu : c_cus)
+                static_cast<const ratio::core::compilation_unit &>(*cu).refine(*this);
+            if (hierarchy_changed) // the consecutive declarations are complete, hence no subtype check will encode them..
+                encode_hierarchy();
+            for (const auto &cu : c_cus)
+                static_cast<const ratio::core::compilation_unit &>(*cu).link(*this);
+            timings.refining += std::chrono::steady_clock::now() - start;
+
+            for (auto &cu : c_cus)
+                cus.emplace_back(std::move(cu));
+            c_cus.clear();
+        };
+
+        size_t pos = 0;
+        size_t line = 1, counted = 0; // the line of the content at which the next chunk starts, counted up to `counted`..
+        while (pos < content.size())
+        {
+            auto start = std::chrono::steady_clock::now();
+            const auto chunk = next_chunk(content, pos);
+            if (chunk.empty())
+                break;
+            const size_t chunk_start = chunk.data() - content.data();
+            line += std::count(content.cbegin() + counted, content.cbegin() + chunk_start, '\n');
+            counted = chunk_start;
+
+            std::unique_ptr<const riddle::ast::compilation_unit> cu;
+            try
+            { // declarations, which are often shared among scripts (e.g., those of a domain), are parsed through the cache, whereas the far more numerous statements are parsed in place..
+                cu = is_declaration(chunk) ? parse(chunk) : parse_in_place(chunk);
+            }
+            catch (const std::exception &e)
+            { // the positions reported by the parser are relative to the chunk, hence we add the line at which the chunk starts..
+                throw std::invalid_argument("line " + std::to_string(line) + ": " + e.what());
+            }
+            timings.parsing += std::chrono::steady_clock::now() - start;
+
+            const auto &c_cu = static_cast<const ratio::core::compilation_unit &>(*cu);
+            if (c_cu.has_declarations())
+            { // we defer the declarations until the next statement, so that consecutive declarations can refer to each other..
+                c_cus.emplace_back(std::move(cu));
+                continue;
+            }
+
+            flush();
+            start = std::chrono::steady_clock::now();
+            c_cu.link(*this);
+            c_cu.execute(*this, ctx);
+            timings.executing += std::chrono::steady_clock::now() - start;
+            if (c_cu.retains_statements())
+                cus.emplace_back(std::move(cu));
+        }
+        flush();
+    }
+
+    std::unique_ptr<const riddle::ast::compilation_unit> core::parse(std::string_view content) const
+    {
+        if (cache_dir.empty())
+            return parse_in_place(content);
+
+        const auto hash = content_hash(content);
+        std::ostringstream cache_path;
+        cache_path << cache_dir << '/' << std::hex << std::setw(16) << std::setfill('0') << hash << ".rcu";
+        try
+        { // we look for a previously cached compilation unit..
+            mapped_file cache(cache_path.str());
+            if (auto cu = read_compilation_unit(cache.get_content(), content))
+                return cu;
+        }
+        catch (const std::exception &)
+        { // the cached compilation unit is either missing or malformed (e.g., truncated or corrupted), hence we parse the content again..
+        }
+
+        auto cu = parse_in_place(content);
+
+        // we cache the compilation unit, writing it to a temporary file first so as not to expose partially written caches..
+        static std::atomic<uint64_t> tmp_counter{0};
+        std::ostringstream tmp_path;
+        tmp_path << cache_path.str() << '.' << std::hex << std::random_device()() << std::random_device()() << '.' << tmp_counter++ << ".tmp"; // unique among the threads and the processes sharing the cache..
+        if (std::ofstream ofs(tmp_path.str(), std::ios::binary); ofs)
+        {
+            write_compilation_unit(ofs, content, *cu);
+            ofs.close();
+            if (!ofs || std::rename(tmp_path.str().c_str(), cache_path.str().c_str()))
+                std::remove(tmp_path.str().c_str());
+        }
+        return cu;
+    }
+
+    RATIOCORE_EXPORT expr core::new_bool(const bool &val) noexcept { return val ? true_itm : false_itm; }
+    RATIOCORE_EXPORT expr core::new_int(const semitone::I &val) noexcept { return new_item<arith_item>(get_int_type(), semitone::lin(semitone::rational(val))); }
+    RATIOCORE_EXPORT expr core::new_real(const semitone::rational &val) noexcept { return new_item<arith_item>(get_real_type(), semitone::lin(val)); }
+    RATIOCORE_EXPORT expr core::new_time_point(const semitone::rational &val) noexcept { return new_item<arith_item>(get_time_type(), semitone::lin(val)); }
+    RATIOCORE_EXPORT expr core::new_string(const std::string &val) noexcept { return new_item<string_item>(get_string_type(), val); }
+
+    expr core::intern_int(const semitone::I &val) noexcept
+    {
+        auto &itm = int_itms[val];
+        if (!itm)
+            itm = new_int(val);
+        return itm;
+    }
+    expr core::intern_real(const semitone::rational &val) noexcept
+    {
+        auto &itm = real_itms[val];
+        if (!itm)
+            itm = new_real(val);
+        return itm;
+    }
+    expr core::intern_string(const std::string &val) noexcept
+    {
+        auto &itm = string_itms[val];
+        if (!itm)
+            itm = new_string(val);
+        return itm;
+    }
+
+    RATIOCORE_EXPORT expr core::get(const symbol &name) noexcept
     {
         if (const auto at_xpr = vars.find(name); at_xpr != vars.cend())
             return at_xpr->second;
@@ -113,6 +468,425 @@ namespace ratio::core
     RATIOCORE_EXPORT std::unordered_set<expr> core::enum_value(const expr &x) const noexcept { return enum_value(static_cast<enum_item &>(*x)); }
     RATIOCORE_EXPORT bool core::is_constant(const enum_item &x) const noexcept { return enum_value(x).size() == 1; }
 
+    RATIOCORE_EXPORT void core::assert_fact(const expr &fact)
+    {
+        if (n_batches && flush_policy == fact_flush_policy::per_body)
+            pending_facts.push_back(fact);
+        else
+            assert_facts({fact});
+    }
+
+    RATIOCORE_EXPORT fact_batch::fact_batch(core &cr) noexcept : cr(cr), start(cr.pending_facts.size()), depth(++cr.n_batches) {}
+    RATIOCORE_EXPORT fact_batch::~fact_batch()
+    {
+        cr.n_batches--;
+        if (!flushed || depth == 1) // the facts of this batch, including those of its nested batches, are discarded..
+            cr.pending_facts.resize(start);
+    }
+    RATIOCORE_EXPORT void fact_batch::flush()
+    {
+        flushed = true;
+        if (depth > 1 || cr.pending_facts.empty())
+            return; // the facts of a nested batch are asserted when the outermost batch is flushed..
+        std::vector<expr> facts;
+        facts.swap(cr.pending_facts);
+        cr.assert_facts(std::move(facts));
+    }
+
+    RATIOCORE_EXPORT expr core::fold_negate(const expr &var) noexcept
+    {
+        const auto l = static_cast<bool_item &>(*var).get_value();
+        if (l == semitone::TRUE_lit)
+            return false_itm;
+        if (l == semitone::FALSE_lit)
+            return true_itm;
+        return negate(var);
+    }
+    RATIOCORE_EXPORT expr core::fold_conj(const std::vector<expr> &exprs) noexcept
+    {
+        std::vector<expr> c_exprs;
+        c_exprs.reserve(exprs.size());
+        std::unordered_map<semitone::var, bool> signs; // the signs of the literals of the conjuncts, indexed by their variable..
+        for (const auto &bex : exprs)
+        {
+            const auto l = static_cast<bool_item &>(*bex).get_value();
+            if (l == semitone::FALSE_lit)
+                return false_itm;
+            if (l == semitone::TRUE_lit)
+                continue; // a true conjunct is redundant..
+            const auto [it, added] = signs.emplace(variable(l), sign(l));
+            if (added)
+                c_exprs.push_back(bex);
+            else if (it->second != sign(l))
+                return false_itm; // two complementary conjuncts..
+        }
+        switch (c_exprs.size())
+        {
+        case 0:
+            return true_itm;
+        case 1:
+            return c_exprs.front();
+        default:
+            return share(expr_op::conj, c_exprs, true, [this, &c_exprs]()
+                         { return conj(c_exprs); });
+        }
+    }
+    RATIOCORE_EXPORT expr core::fold_disj(const std::vector<expr> &exprs) noexcept
+    {
+        std::vector<expr> c_exprs;
+        c_exprs.reserve(exprs.size());
+        std::unordered_map<semitone::var, bool> signs; // the signs of the literals of the disjuncts, indexed by their variable..
+        for (const auto &bex : exprs)
+        {
+            const auto l = static_cast<bool_item &>(*bex).get_value();
+            if (l == semitone::TRUE_lit)
+                return true_itm;
+            if (l == semitone::FALSE_lit)
+                continue; // a false disjunct is redundant..
+            const auto [it, added] = signs.emplace(variable(l), sign(l));
+            if (added)
+                c_exprs.push_back(bex);
+            else if (it->second != sign(l))
+                return true_itm; // two complementary disjuncts..
+        }
+        switch (c_exprs.size())
+        {
+        case 0:
+            return false_itm;
+        case 1:
+            return c_exprs.front();
+        default:
+            return share(expr_op::disj, c_exprs, true, [this, &c_exprs]()
+                         { return disj(c_exprs); });
+        }
+    }
+    RATIOCORE_EXPORT expr core::fold_exct_one(const std::vector<expr> &exprs) noexcept
+    {
+        struct occurrences
+        {
+            expr pos, neg;               // an operand having the variable with a positive and with a negative sign, if any..
+            size_t n_pos = 0, n_neg = 0; // the number of operands having the variable with a positive and with a negative sign..
+        };
+        std::vector<occurrences> occs;
+        std::unordered_map<semitone::var, size_t> occ_idx; // the index of the occurrences of each variable..
+        size_t n_true = 0;                                   // the number of true operands..
+        for (const auto &bex : exprs)
+        {
+            const auto l = static_cast<bool_item &>(*bex).get_value();
+            if (l == semitone::TRUE_lit)
+                n_true++;
+            else if (l != semitone::FALSE_lit)
+            {
+                const auto [it, added] = occ_idx.emplace(variable(l), occs.size());
+                if (added)
+                    occs.emplace_back();
+                auto &occ = occs[it->second];
+                if (sign(l))
+                {
+                    if (!occ.n_pos++)
+                        occ.pos = bex;
+                }
+                else if (!occ.n_neg++)
+                    occ.neg = bex;
+            }
+        }
+
+        // a variable appearing with both signs makes at least one of its operands true..
+        const occurrences *mixed = nullptr;
+        for (const auto &occ : occs)
+            if (occ.n_pos && occ.n_neg)
+            {
+                if (n_true || mixed)
+                    return false_itm; // at least two operands are true..
+                mixed = &occ;
+            }
+
+        std::vector<expr> c_exprs; // the conjuncts equivalent to the exact-one..
+        if (n_true || mixed)
+        { // exactly one operand is already true, hence all the other operands must be false..
+            if (n_true > 1)
+                return false_itm;
+            for (const auto &occ : occs)
+                if (&occ == mixed)
+                { // the operands of this variable must make exactly one operand true..
+                    if (occ.n_pos > 1 && occ.n_neg > 1)
+                        return false_itm;
+                    if (occ.n_neg > 1)
+                        c_exprs.push_back(occ.pos);
+                    else if (occ.n_pos > 1)
+                        c_exprs.push_back(occ.neg);
+                }
+                else
+                    c_exprs.push_back(fold_negate(occ.n_pos ? occ.pos : occ.neg));
+            return fold_conj(c_exprs);
+        }
+
+        std::vector<expr> c_ops; // the operands which can be the true one..
+        for (const auto &occ : occs)
+        {
+            const auto &op = occ.n_pos ? occ.pos : occ.neg;
+            if (occ.n_pos + occ.n_neg > 1)
+                c_exprs.push_back(fold_negate(op)); // a repeated operand cannot be the only true one..
+            else
+                c_ops.push_back(op);
+        }
+        switch (c_ops.size())
+        {
+        case 0:
+            return false_itm;
+        case 1:
+            c_exprs.push_back(c_ops.front());
+            break;
+        default:
+            c_exprs.push_back(exct_one(c_ops));
+        }
+        return fold_conj(c_exprs);
+    }
+
+    RATIOCORE_EXPORT expr core::add(const std::vector<expr> &exprs) noexcept
+    {
+        assert(exprs.size() > 1);
+        semitone::lin l;
+        for (const auto &aex : exprs)
+            l += static_cast<arith_item &>(*aex).get_value();
+        return new_arith(get_type(exprs), l);
+    }
+    RATIOCORE_EXPORT expr core::sub(const std::vector<expr> &exprs) noexcept
+    {
+        assert(exprs.size() > 1);
+        semitone::lin l = static_cast<arith_item &>(*exprs.front()).get_value();
+        for (auto it = std::next(exprs.cbegin()); it != exprs.cend(); ++it)
+            l -= static_cast<arith_item &>(**it).get_value();
+        return new_arith(get_type(exprs), l);
+    }
+    RATIOCORE_EXPORT expr core::mult(const std::vector<expr> &exprs) noexcept
+    {
+        assert(exprs.size() > 1);
+        const arith_item *var_itm = nullptr; // the only non-constant factor, if any..
+        semitone::rational c(1);             // the product of the constant factors..
+        for (const auto &aex : exprs)
+        {
+            const auto &itm = static_cast<arith_item &>(*aex);
+            if (itm.get_value().vars.empty())
+                c *= itm.get_value().known_term;
+            else if (var_itm)
+                return nullptr; // the product is not linear..
+            else
+                var_itm = &itm;
+        }
+        return new_arith(get_type(exprs), var_itm ? var_itm->get_value() * c : semitone::lin(c));
+    }
+    RATIOCORE_EXPORT expr core::div(const std::vector<expr> &exprs) noexcept
+    {
+        assert(exprs.size() > 1);
+        semitone::rational c(1); // the product of the divisors..
+        for (auto it = std::next(exprs.cbegin()); it != exprs.cend(); ++it)
+        {
+            const auto &l = static_cast<arith_item &>(**it).get_value();
+            if (!l.vars.empty() || l.known_term == semitone::rational(0))
+                return nullptr; // the divisor is not a non-zero constant..
+            c *= l.known_term;
+        }
+        auto &tp = get_type(exprs);
+        const auto l = static_cast<arith_item &>(*exprs.front()).get_value() / c;
+        if (&tp == &get_int_type() && (!l.vars.empty() || l.known_term.denominator() != 1))
+            return nullptr; // the quotient might not be an integer..
+        return new_arith(tp, l);
+    }
+    RATIOCORE_EXPORT expr core::minus(const expr &ex) noexcept { return new_arith(ex->get_type(), -static_cast<arith_item &>(*ex).get_value()); }
+
+    /**
+     * Checks whether all the given arithmetic expressions are constant.
+     */
+    bool are_constant(const std::vector<expr> &exprs) noexcept
+    {
+        return std::all_of(exprs.cbegin(), exprs.cend(), [](const auto &aex)
+                           { return static_cast<arith_item &>(*aex).get_value().vars.empty(); });
+    }
+
+    RATIOCORE_EXPORT expr core::fold_add(const std::vector<expr> &exprs) noexcept
+    {
+        assert(exprs.size() > 1);
+        if (are_constant(exprs))
+        { // the sum is a literal..
+            semitone::rational c(0);
+            for (const auto &aex : exprs)
+                c += static_cast<arith_item &>(*aex).get_value().known_term;
+            return new_arith(get_type(exprs), semitone::lin(c));
+        }
+        return share(expr_op::add, exprs, true, [this, &exprs]()
+                     { return add(exprs); });
+    }
+    RATIOCORE_EXPORT expr core::fold_sub(const std::vector<expr> &exprs) noexcept
+    {
+        assert(exprs.size() > 1);
+        if (!are_constant(exprs))
+            return sub(exprs);
+        semitone::rational c = static_cast<arith_item &>(*exprs.front()).get_value().known_term;
+        for (auto it = std::next(exprs.cbegin()); it != exprs.cend(); ++it)
+            c -= static_cast<arith_item &>(**it).get_value().known_term;
+        return new_arith(get_type(exprs), semitone::lin(c));
+    }
+    RATIOCORE_EXPORT expr core::fold_mult(const std::vector<expr> &exprs) noexcept
+    {
+        assert(exprs.size() > 1);
+        if (!are_constant(exprs))
+            return mult(exprs);
+        semitone::rational c(1);
+        for (const auto &aex : exprs)
+            c *= static_cast<arith_item &>(*aex).get_value().known_term;
+        return new_arith(get_type(exprs), semitone::lin(c));
+    }
+    RATIOCORE_EXPORT expr core::fold_div(const std::vector<expr> &exprs) noexcept
+    {
+        assert(exprs.size() > 1);
+        if (!are_constant(exprs))
+            return div(exprs);
+        semitone::rational c = static_cast<arith_item &>(*exprs.front()).get_value().known_term;
+        for (auto it = std::next(exprs.cbegin()); it != exprs.cend(); ++it)
+        {
+            const auto &d = static_cast<arith_item &>(**it).get_value().known_term;
+            if (d == semitone::rational(0))
+                return div(exprs); // the division by zero is left to `div`..
+            c /= d;
+        }
+        auto &tp = get_type(exprs);
+        if (&tp == &get_int_type() && c.denominator() != 1)
+            return div(exprs); // the quotient is not an integer..
+        return new_arith(tp, semitone::lin(c));
+    }
+    RATIOCORE_EXPORT expr core::fold_minus(const expr &ex) noexcept
+    {
+        const auto &l = static_cast<arith_item &>(*ex).get_value();
+        if (l.vars.empty())
+            return new_arith(ex->get_type(), semitone::lin(-l.known_term));
+        return minus(ex);
+    }
+
+    RATIOCORE_EXPORT expr core::fold_lt(const expr &left, const expr &right) noexcept
+    {
+        const auto &l = static_cast<arith_item &>(*left).get_value();
+        const auto &r = static_cast<arith_item &>(*right).get_value();
+        if (l.vars.empty() && r.vars.empty())
+            return new_bool(l.known_term < r.known_term);
+        return share(expr_op::lt, {left, right}, false, [this, &left, &right]()
+                     { return lt(left, right); });
+    }
+    RATIOCORE_EXPORT expr core::fold_leq(const expr &left, const expr &right) noexcept
+    {
+        const auto &l = static_cast<arith_item &>(*left).get_value();
+        const auto &r = static_cast<arith_item &>(*right).get_value();
+        if (l.vars.empty() && r.vars.empty())
+            return new_bool(l.known_term <= r.known_term);
+        return share(expr_op::leq, {left, right}, false, [this, &left, &right]()
+                     { return leq(left, right); });
+    }
+    RATIOCORE_EXPORT expr core::fold_eq(const expr &left, const expr &right) noexcept
+    {
+        if (left == right)
+            return true_itm;
+        if ((left == true_itm || left == false_itm) && (right == true_itm || right == false_itm))
+            return false_itm; // two different boolean literals..
+        const auto l_itm = dynamic_cast<arith_item *>(left.get());
+        const auto r_itm = dynamic_cast<arith_item *>(right.get());
+        if (l_itm && r_itm && l_itm->get_value().vars.empty() && r_itm->get_value().vars.empty())
+            return new_bool(l_itm->get_value().known_term == r_itm->get_value().known_term);
+        return share(expr_op::eq, {left, right}, true, [this, &left, &right]()
+                     { return eq(left, right); });
+    }
+    RATIOCORE_EXPORT expr core::fold_geq(const expr &left, const expr &right) noexcept
+    {
+        const auto &l = static_cast<arith_item &>(*left).get_value();
+        const auto &r = static_cast<arith_item &>(*right).get_value();
+        if (l.vars.empty() && r.vars.empty())
+            return new_bool(l.known_term >= r.known_term);
+        return share(expr_op::geq, {left, right}, false, [this, &left, &right]()
+                     { return geq(left, right); });
+    }
+    RATIOCORE_EXPORT expr core::fold_gt(const expr &left, const expr &right) noexcept
+    {
+        const auto &l = static_cast<arith_item &>(*left).get_value();
+        const auto &r = static_cast<arith_item &>(*right).get_value();
+        if (l.vars.empty() && r.vars.empty())
+            return new_bool(l.known_term > r.known_term);
+        return share(expr_op::gt, {left, right}, false, [this, &left, &right]()
+                     { return gt(left, right); });
+    }
+
+    RATIOCORE_EXPORT expr core::new_arith(type &tp, const semitone::lin &l) noexcept
+    {
+        if (!l.vars.empty())
+            return new_item<arith_item>(tp, l);
+        if (&tp == &get_int_type())
+        {
+            assert(l.known_term.denominator() == 1);
+            return new_int(l.known_term.numerator());
+        }
+        if (&tp == &get_time_type())
+            return new_time_point(l.known_term);
+        return new_real(l.known_term);
+    }
+
+    RATIOCORE_EXPORT std::vector<expr> core::new_atoms(predicate &pred, const size_t &n, const std::vector<std::string> &names, const std::vector<std::vector<expr>> &columns, const bool &is_fact)
+    {
+        if (names.size() != columns.size())
+            throw std::invalid_argument("the number of columns differs from the number of names");
+        for (size_t i = 0; i < names.size(); ++i)
+            if (columns[i].size() != n)
+                throw std::invalid_argument("column '" + names[i] + "' has not " + std::to_string(n) + " values");
+
+        std::vector<symbol> c_names;
+        c_names.reserve(names.size());
+        for (const auto &name : names)
+            c_names.emplace_back(name);
+        return instantiate_atoms(pred, n, c_names, columns, is_fact);
+    }
+
+    std::vector<expr> core::instantiate_atoms(predicate &pred, const size_t &n, const std::vector<symbol> &names, const std::vector<std::vector<expr>> &columns, const bool &is_fact)
+    {
+        // the arguments of the new atoms, along with their column (or `columns.size()` if the argument has to be initialized) and their type..
+        symbol_map<std::pair<size_t, type *>> layout;
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            type &tt = names[i] == tau_sym ? static_cast<type &>(pred.get_scope()) : pred.get_field(names[i].str()).get_type(); // the target type..
+            for (auto e : columns[i])
+                if (tt.is_assignable_from(e->get_type())) // the target type is a superclass of the assignment..
+                    continue;
+                else if (e->get_type().is_assignable_from(tt)) // the target type is a subclass of the assignment..
+                    if (enum_item *ae = dynamic_cast<enum_item *>(&*e))
+                    { // some of the allowed values might be inhibited..
+                        for (auto ev : enum_value(*ae))
+                            if (!tt.is_assignable_from(ev->get_type())) // the target type is not a superclass of the value..
+                                remove(e, ev);
+                    }
+                    else // the value is a constant which cannot be assigned to the target type (which is a subclass of the type of the value)..
+                        throw inconsistency_exception();
+                else // the value is unrelated with the target type (we are probably in the presence of a modeling error!)..
+                    throw inconsistency_exception();
+            layout.emplace(names[i], i, &tt);
+        }
+        if (&pred.get_scope() != this) // the atoms are scoped by any of the instances of the enclosing type..
+            layout.emplace(tau_sym, columns.size(), &static_cast<type &>(pred.get_scope()));
+
+        // the unassigned arguments, including those of the super-predicates, will be initialized..
+        for (const auto &sp : pred.get_ancestors())
+            for (const auto &arg : static_cast<predicate *>(sp)->get_args())
+                layout.emplace(arg->get_symbol(), columns.size(), &arg->get_type());
+
+        auto atms = pred.new_instances(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto &c_atm = static_cast<atom &>(*atms[i]);
+            for (const auto &[name, arg] : layout)
+                if (arg.first < columns.size())
+                    c_atm.set_var(name, columns[arg.first][i]);
+                else
+                    c_atm.set_var(name, arg.second->is_primitive() ? arg.second->new_instance() : arg.second->new_existential());
+            new_atom(c_atm, is_fact);
+        }
+        return atms;
+    }
+
     RATIOCORE_EXPORT void core::new_disjunction([[maybe_unused]] const std::vector<std::unique_ptr<conjunction>> conjs) {}
 
     RATIOCORE_EXPORT type &core::get_type(const std::vector<expr> &exprs) const
@@ -129,20 +903,52 @@ namespace ratio::core
         else
             return get_real_type();
     }
-    RATIOCORE_EXPORT void core::new_method(method_ptr m) noexcept { methods[m->get_name()].emplace_back(std::move(m)); }
+    RATIOCORE_EXPORT void core::new_method(method_ptr m) noexcept
+    {
+        methods[m->get_name()].emplace_back(std::move(m));
+        cc_stats.epoch++; // the new method might change the resolution of the cached overloads..
+    }
+    void core::encode_hierarchy()
+    {
+        std::vector<bool> encoded(n_types, false);
+        std::queue<const scope *> q;
+        q.push(this);
+        while (!q.empty())
+        {
+            for (const auto &[tp_name, tp] : q.front()->get_types())
+            {
+                tp->encode_ancestors(encoded);
+                q.push(tp.get());
+            }
+            for (const auto &[pred_name, pred] : q.front()->get_predicates())
+            {
+                pred->encode_ancestors(encoded);
+                q.push(pred.get());
+            }
+            q.pop();
+        }
+
+        // the numeric primitive types are assignable from each other, except for `int` and `real`..
+        it->add_ancestor(*tt);
+        rt->add_ancestor(*tt);
+        tt->add_ancestor(*it);
+        tt->add_ancestor(*rt);
+        hierarchy_changed = false;
+    }
+
     RATIOCORE_EXPORT void core::new_type(type_ptr t) noexcept { types.emplace(t->get_name(), std::move(t)); }
     RATIOCORE_EXPORT void core::new_predicate(predicate_ptr p) noexcept { predicates.emplace(p->get_name(), std::move(p)); }
 
-    RATIOCORE_EXPORT const field &core::get_field(const std::string &name) const
+    RATIOCORE_EXPORT const field *core::find_field(const std::string &name) const noexcept
     {
         if (const auto at_f = get_fields().find(name); at_f != get_fields().cend())
-            return *at_f->second;
+            return at_f->second.get();
 
         // not found
-        throw std::out_of_range(name);
+        return nullptr;
     }
 
-    RATIOCORE_EXPORT method &core::get_method(const std::string &name, const std::vector<const type *> &ts) const
+    RATIOCORE_EXPORT method *core::find_method(const std::string &name, const std::vector<const type *> &ts) const noexcept
     {
         if (const auto at_m = methods.find(name); at_m != methods.cend())
         {
@@ -158,30 +964,30 @@ namespace ratio::core
                             break;
                         }
                     if (found)
-                        return *mthd;
+                        return mthd.get();
                 }
         }
 
         // not found
-        throw std::out_of_range(name);
+        return nullptr;
     }
 
-    RATIOCORE_EXPORT type &core::get_type(const std::string &name) const
+    RATIOCORE_EXPORT type *core::find_type(const std::string &name) const noexcept
     {
         if (const auto at_tp = types.find(name); at_tp != types.cend())
-            return *at_tp->second;
+            return at_tp->second.get();
 
         // not found
-        throw std::out_of_range(name);
+        return nullptr;
     }
 
-    RATIOCORE_EXPORT predicate &core::get_predicate(const std::string &name) const
+    RATIOCORE_EXPORT predicate *core::find_predicate(const std::string &name) const noexcept
     {
         if (const auto at_p = predicates.find(name); at_p != predicates.cend())
-            return *at_p->second;
+            return at_p->second.get();
 
         // not found
-        throw std::out_of_range(name);
+        return nullptr;
     }
 
 #ifdef COMPUTE_NAMES
@@ -189,10 +995,10 @@ namespace ratio::core
     {
         expr_names.clear();
 
-        std::queue<std::pair<std::string, expr>> q;
+        std::queue<std::pair<symbol, expr>> q;
         for (const auto &xpr : vars)
         {
-            expr_names.emplace(&*xpr.second, xpr.first);
+            expr_names.emplace(&*xpr.second, xpr.first.str());
             if (!xpr.second->get_type().is_primitive())
                 if (const atom *a = dynamic_cast<const atom *>(&*xpr.second); !a)
                     q.push(xpr);
@@ -201,8 +1007,8 @@ namespace ratio::core
         while (!q.empty())
         {
             const auto &c_xpr = q.front();
-            for (const auto &xpr : static_cast<complex_item &>(*c_xpr.second).vars)
-                if (expr_names.emplace(&*xpr.second, expr_names.at(&*c_xpr.second) + '.' + xpr.first).second)
+            for (const auto &xpr : static_cast<complex_item &>(*c_xpr.second).get_vars())
+                if (expr_names.emplace(&*xpr.second, expr_names.at(&*c_xpr.second) + '.' + xpr.first.str()).second)
                     q.push(xpr);
             q.pop();
         }
@@ -215,10 +1021,11 @@ namespace ratio::core
         for (const auto &l : listeners)
             l->log(msg);
     }
-    RATIOCORE_EXPORT void core::fire_read(const std::string &script) const noexcept
+    RATIOCORE_EXPORT void core::fire_read(std::string_view script) const noexcept
     {
+        const std::string c_script(script);
         for (const auto &l : listeners)
-            l->read(script);
+            l->read(c_script);
     }
     RATIOCORE_EXPORT void core::fire_read(const std::vector<std::string> &files) const noexcept
     {
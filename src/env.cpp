@@ -6,7 +6,7 @@ namespace ratio::core
     env::env(env &e) : e(e) {}
     env::env(context ctx) : e(*ctx), ctx(ctx) {}
 
-    RATIOCORE_EXPORT expr env::get(const std::string &name)
+    RATIOCORE_EXPORT expr env::get(const symbol &name)
     {
         if (const auto at_xpr = vars.find(name); at_xpr != vars.cend())
             return at_xpr->second;
@@ -15,4 +15,48 @@ namespace ratio::core
         else
             return e.get(name);
     }
+
+    RATIOCORE_EXPORT void env::set(const symbol &name, expr xpr) { vars.emplace(name, std::move(xpr)); }
+
+    RATIOCORE_EXPORT expr frame::get(const symbol &name)
+    {
+        for (size_t i = 0; i < n_inline; ++i)
+            if (ids[i] == name.get_id())
+                return vals[i];
+        return env::get(name);
+    }
+
+    RATIOCORE_EXPORT void frame::set(const symbol &name, expr xpr)
+    {
+        for (size_t i = 0; i < n_inline; ++i)
+            if (ids[i] == name.get_id())
+                return;
+        if (n_inline < inline_capacity && vars.empty())
+        { // the variable fits inline..
+            ids[n_inline] = name.get_id();
+            names[n_inline] = &name.str();
+            vals[n_inline++] = std::move(xpr);
+        }
+        else
+            env::set(name, std::move(xpr));
+    }
+
+    RATIOCORE_EXPORT context frame::promote() const
+    {
+        const env *root = &e; // the chain of the enclosing environments ends with the core, which encloses itself..
+        while (&root->e != root)
+            root = &root->e;
+        auto ctx = static_cast<core &>(const_cast<env &>(*root)).new_pooled<env>(e);
+        for (size_t i = 0; i < n_inline; ++i)
+            ctx->vars.emplace(symbol(ids[i], *names[i]), vals[i]);
+        ctx->vars.insert(vars.cbegin(), vars.cend());
+        return ctx;
+    }
+
+    RATIOCORE_EXPORT context capture(const context &ctx)
+    {
+        if (ctx.use_count()) // the context owns its environment..
+            return ctx;
+        return static_cast<const frame &>(*ctx).promote(); // only frames are referred through non-owning contexts..
+    }
 } // namespace ratio::core
\ No newline at end of file
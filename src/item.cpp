@@ -2,7 +2,6 @@
 #include "type.h"
 #include "core.h"
 #include "riddle_lexer.h"
-#include <queue>
 #include <cassert>
 
 namespace ratio::core
@@ -15,50 +14,64 @@ namespace ratio::core
 
     RATIOCORE_EXPORT string_item::string_item(type &t, const std::string &l) : item(t), l(l) { assert(t.get_name() == STRING_KW); }
 
-    RATIOCORE_EXPORT complex_item::complex_item(type &tp) : item(tp), env(tp.get_core()) {}
+    RATIOCORE_EXPORT complex_item::complex_item(type &tp) : item(tp), env(tp.get_core()), layout(tp.get_layout()), slots(layout.size()) {}
 
-    RATIOCORE_EXPORT expr complex_item::get(const std::string &name) noexcept
+    RATIOCORE_EXPORT expr complex_item::get(const symbol &name) noexcept { return find_var(name); }
+
+    RATIOCORE_EXPORT expr complex_item::find_var(const symbol &name) const noexcept
     {
-        if (const auto at_xpr = vars.find(name); at_xpr != vars.cend())
+        if (const auto at_f = layout.find(name); at_f != layout.cend())
+            return slots[at_f - layout.cbegin()];
+        else if (const auto at_xpr = vars.find(name); at_xpr != vars.cend())
             return at_xpr->second;
         else
             return nullptr;
     }
 
-    RATIOCORE_EXPORT enum_item::enum_item(type &t, semitone::var ev) : complex_item(t), ev(ev) {}
-
-    RATIOCORE_EXPORT expr enum_item::get(const std::string &name) noexcept
+    RATIOCORE_EXPORT bool complex_item::set_var(const symbol &name, expr xpr) noexcept
     {
-        std::map<std::string, const field *> accessible_fields;
-        std::queue<type *> q;
-        q.push(&get_type());
-        while (!q.empty())
+        if (const auto at_f = layout.find(name); at_f != layout.cend())
         {
-            for (const auto &f : q.front()->get_fields())
-                accessible_fields.try_emplace(f.first, f.second.get());
-            for (const auto &st : q.front()->get_supertypes())
-                q.push(st);
-            q.pop();
+            auto &slot = slots[at_f - layout.cbegin()];
+            if (slot)
+                return false;
+            slot = std::move(xpr);
+            return true;
         }
-        if (!accessible_fields.count(name))
+        else
+            return vars.emplace(name, std::move(xpr)).second;
+    }
+
+    RATIOCORE_EXPORT std::vector<std::pair<symbol, expr>> complex_item::get_vars() const noexcept
+    {
+        std::vector<std::pair<symbol, expr>> c_vars;
+        c_vars.reserve(slots.size() + vars.size());
+        for (size_t i = 0; i < slots.size(); ++i)
+            if (slots[i])
+                c_vars.emplace_back((layout.cbegin() + i)->first, slots[i]);
+        c_vars.insert(c_vars.end(), vars.cbegin(), vars.cend());
+        return c_vars;
+    }
+
+    RATIOCORE_EXPORT enum_item::enum_item(type &t, semitone::var ev) : complex_item(t), ev(ev) {}
+
+    RATIOCORE_EXPORT expr enum_item::get(const symbol &name) noexcept
+    {
+        if (!get_type().find_inherited_field(name))
             return complex_item::get(name);
+        else if (auto c_xpr = find_var(name))
+            return c_xpr;
         else
         {
-            const auto &it_it = vars.lower_bound(name);
-            if (it_it == vars.cend())
-            {
-                assert(!get_type().get_core().enum_value(*this).empty());
-                if (auto vs = get_type().get_core().enum_value(*this); vs.size() == 1)
-                    return (static_cast<complex_item *>(vs.cbegin()->get()))->get(name);
-                else
-                { // we generate a new variable..
-                    auto e = get_type().get_core().get(*this, name);
-                    vars.emplace_hint(it_it, name, e);
-                    return e;
-                }
-            }
+            assert(!get_type().get_core().enum_value(*this).empty());
+            if (auto vs = get_type().get_core().enum_value(*this); vs.size() == 1)
+                return (static_cast<complex_item *>(vs.cbegin()->get()))->get(name);
             else
-                return it_it->second;
+            { // we generate a new variable..
+                auto e = get_type().get_core().get(*this, name.str());
+                set_var(name, e);
+                return e;
+            }
         }
     }
 } // namespace ratio::core
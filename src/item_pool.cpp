@@ -0,0 +1,46 @@
+#include "item_pool.h"
+#include <new>
+#include <cassert>
+
+namespace ratio::core
+{
+    RATIOCORE_EXPORT item_pool::~item_pool() { assert(n_blocks == 0); } // an object allocated from this pool would otherwise outlive it, writing into a released chunk once deallocated..
+
+    RATIOCORE_EXPORT void *item_pool::allocate(size_t size)
+    {
+        n_blocks++;
+        if (size > max_block_size)
+            return ::operator new(size);
+
+        const size_t cls = (size + granularity - 1) / granularity - 1;
+        if (free_block *blk = free_lists[cls])
+        { // we reuse a deallocated block..
+            free_lists[cls] = blk->next;
+            return blk;
+        }
+
+        const size_t blk_size = (cls + 1) * granularity;
+        if (remaining < blk_size)
+        { // we need a new chunk (the remainder of the last chunk, if any, is wasted)..
+            chunks.emplace_back(new char[chunk_size]);
+            next_block = chunks.back().get();
+            remaining = chunk_size;
+        }
+        void *blk = next_block;
+        next_block += blk_size;
+        remaining -= blk_size;
+        return blk;
+    }
+
+    RATIOCORE_EXPORT void item_pool::deallocate(void *p, size_t size) noexcept
+    {
+        n_blocks--;
+        if (size > max_block_size)
+            ::operator delete(p);
+        else
+        { // we make the block available again..
+            const size_t cls = (size + granularity - 1) / granularity - 1;
+            free_lists[cls] = new (p) free_block{free_lists[cls]};
+        }
+    }
+} // namespace ratio::core
@@ -0,0 +1,89 @@
+#include "mapped_file.h"
+#include <stdexcept>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ratio::core
+{
+#ifdef _WIN32
+    RATIOCORE_EXPORT mapped_file::mapped_file(const std::string &path)
+    {
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::invalid_argument("cannot find file '" + path + "'");
+
+        LARGE_INTEGER f_size;
+        if (!GetFileSizeEx(file, &f_size))
+        {
+            CloseHandle(file);
+            throw std::invalid_argument("cannot read file '" + path + "'");
+        }
+        size = static_cast<size_t>(f_size.QuadPart);
+        if (!size) // empty files cannot be mapped..
+            return;
+
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            throw std::invalid_argument("cannot map file '" + path + "'");
+        }
+        data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!data)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            throw std::invalid_argument("cannot map file '" + path + "'");
+        }
+    }
+
+    RATIOCORE_EXPORT mapped_file::~mapped_file()
+    {
+        if (data)
+            UnmapViewOfFile(data);
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+    }
+#else
+    RATIOCORE_EXPORT mapped_file::mapped_file(const std::string &path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            throw std::invalid_argument("cannot find file '" + path + "'");
+
+        struct stat st;
+        if (fstat(fd, &st) == -1)
+        {
+            close(fd);
+            throw std::invalid_argument("cannot read file '" + path + "'");
+        }
+        size = static_cast<size_t>(st.st_size);
+        if (size) // empty files cannot be mapped..
+        {
+            void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED)
+            {
+                close(fd);
+                throw std::invalid_argument("cannot map file '" + path + "'");
+            }
+            madvise(addr, size, MADV_SEQUENTIAL); // the file is lexed from the beginning to the end..
+            data = static_cast<const char *>(addr);
+        }
+        close(fd); // the mapping remains valid after closing the file..
+    }
+
+    RATIOCORE_EXPORT mapped_file::~mapped_file()
+    {
+        if (data)
+            munmap(const_cast<char *>(data), size);
+    }
+#endif
+} // namespace ratio::core
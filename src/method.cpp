@@ -6,7 +6,7 @@
 
 namespace ratio::core
 {
-    RATIOCORE_EXPORT method::method(scope &scp, type *return_type, const std::string &name, std::vector<field_ptr> args, const std::vector<std::unique_ptr<const riddle::ast::statement>> &stmnts) : scope(scp), return_type(return_type), name(name), statements(stmnts)
+    RATIOCORE_EXPORT method::method(scope &scp, type *return_type, const std::string &name, std::vector<field_ptr> args, const std::vector<const statement *> &stmnts) : scope(scp), return_type(return_type), name(name), statements(&stmnts)
     {
         this->args.reserve(args.size());
         for (auto &f : args)
@@ -22,13 +22,16 @@ namespace ratio::core
         assert(args.size() == exprs.size());
         context c_ctx(ctx);
         for (size_t i = 0; i < args.size(); ++i)
-            c_ctx->vars.emplace(args.at(i)->get_name(), exprs.at(i));
+            c_ctx->set(args.at(i)->get_symbol(), exprs.at(i));
 
-        for (const auto &s : statements)
-            dynamic_cast<const statement &>(*s).execute(*this, c_ctx);
+        if (body)
+            body->run(*this, c_ctx);
+        else
+            for (const auto &s : *statements)
+                s->execute(*this, c_ctx);
 
         if (return_type)
-            return c_ctx->vars.at(RETURN_KW);
+            return c_ctx->get(return_sym);
         else
             return nullptr;
     }
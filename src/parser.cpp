@@ -6,319 +6,474 @@
 #include "constructor.h"
 #include "field.h"
 #include "conjunction.h"
+#include "ast_serializer.h"
 #include <unordered_map>
-#include <queue>
+#include <sstream>
+#include <algorithm>
 
 namespace ratio::core
 {
     inline bool is_core(const scope &scp) noexcept { return &scp == &scp.get_core(); }
 
-    expr bool_literal_expression::evaluate(scope &scp, context &) const { return scp.get_core().new_bool(literal.val); }
-    expr int_literal_expression::evaluate(scope &scp, context &) const { return scp.get_core().new_int(literal.val); }
-    expr real_literal_expression::evaluate(scope &scp, context &) const { return scp.get_core().new_real(literal.val); }
-    expr string_literal_expression::evaluate(scope &scp, context &) const { return scp.get_core().new_string(literal.str); }
+    type &resolve_type(scope &scp, const std::vector<riddle::id_token> &path)
+    {
+        scope *s = &scp;
+        for (const auto &id_tk : path)
+            s = &s->get_type(id_tk.id);
+        return static_cast<type &>(*s);
+    }
 
-    expr cast_expression::evaluate(scope &scp, context &ctx) const { return static_cast<const ratio::core::expression &>(*xpr).evaluate(scp, ctx); }
+    void link_expressions(scope &scp, const std::vector<const ratio::core::expression *> &xprs)
+    {
+        for (const auto &xpr : xprs)
+            if (xpr)
+                xpr->link(scp);
+    }
+    void link_statements(scope &scp, const std::vector<const ratio::core::statement *> &stmnts)
+    {
+        for (const auto &stmnt : stmnts)
+            stmnt->link(scp);
+    }
 
-    expr plus_expression::evaluate(scope &scp, context &ctx) const { return static_cast<const ratio::core::expression &>(*xpr).evaluate(scp, ctx); }
-    expr minus_expression::evaluate(scope &scp, context &ctx) const { return scp.get_core().minus(static_cast<const ratio::core::expression &>(*xpr).evaluate(scp, ctx)); }
-    expr not_expression::evaluate(scope &scp, context &ctx) const { return scp.get_core().negate(static_cast<const ratio::core::expression &>(*xpr).evaluate(scp, ctx)); }
+    std::vector<expr> evaluate_expressions(scope &scp, context &ctx, const std::vector<const ratio::core::expression *> &xprs)
+    {
+        std::vector<expr> exprs;
+        exprs.reserve(xprs.size());
+        for (const auto &xpr : xprs)
+            exprs.emplace_back(xpr ? xpr->evaluate(scp, ctx) : nullptr);
+        return exprs;
+    }
 
-    expr constructor_expression::evaluate(scope &scp, context &ctx) const
+    std::vector<uint32_t> compile_expressions(program &p, const std::vector<const ratio::core::expression *> &xprs)
     {
-        scope *s = &scp;
-        for (const auto &tp : instance_type)
-            s = &s->get_type(tp.id);
+        std::vector<uint32_t> regs;
+        regs.reserve(xprs.size());
+        for (const auto &xpr : xprs)
+            regs.push_back(xpr ? xpr->compile(p) : program::no_reg);
+        return regs;
+    }
+    void compile_statements(program &p, const std::vector<const ratio::core::statement *> &stmnts)
+    {
+        p.clear();
+        for (const auto &stmnt : stmnts)
+            stmnt->compile(p);
+    }
 
-        std::vector<expr> exprs;
-        std::vector<const type *> par_types;
-        for (const auto &ex : expressions)
-        {
-            expr i = static_cast<const ratio::core::expression &>(*ex).evaluate(scp, ctx);
-            exprs.emplace_back(i);
-            par_types.emplace_back(&i->get_type());
-        }
+    expr bool_literal_expression::evaluate(scope &scp, context &) const
+    {
+        if (!c_val)
+            c_val = scp.get_core().new_bool(literal.val);
+        return c_val;
+    }
+    uint32_t bool_literal_expression::compile(program &p) const { return p.emit(opcode::new_bool, this); }
+    expr int_literal_expression::evaluate(scope &scp, context &) const
+    {
+        if (!c_val)
+            c_val = scp.get_core().intern_int(literal.val);
+        return c_val;
+    }
+    uint32_t int_literal_expression::compile(program &p) const { return p.emit(opcode::new_int, this); }
+    expr real_literal_expression::evaluate(scope &scp, context &) const
+    {
+        if (!c_val)
+            c_val = scp.get_core().intern_real(literal.val);
+        return c_val;
+    }
+    uint32_t real_literal_expression::compile(program &p) const { return p.emit(opcode::new_real, this); }
+    expr string_literal_expression::evaluate(scope &scp, context &) const
+    {
+        if (!c_val)
+            c_val = scp.get_core().intern_string(literal.str);
+        return c_val;
+    }
+    uint32_t string_literal_expression::compile(program &p) const { return p.emit(opcode::new_string, this); }
+
+    expr cast_expression::evaluate(scope &scp, context &ctx) const { return c_xpr->evaluate(scp, ctx); }
+    void cast_expression::link(scope &scp) const { c_xpr->link(scp); }
+    uint32_t cast_expression::compile(program &p) const { return c_xpr->compile(p); }
 
-        return static_cast<type *>(s)->get_constructor(par_types).new_instance(std::move(exprs));
+    expr plus_expression::evaluate(scope &scp, context &ctx) const { return c_xpr->evaluate(scp, ctx); }
+    void plus_expression::link(scope &scp) const { c_xpr->link(scp); }
+    uint32_t plus_expression::compile(program &p) const { return c_xpr->compile(p); }
+    expr minus_expression::evaluate(scope &scp, context &ctx) const { return scp.get_core().fold_minus(c_xpr->evaluate(scp, ctx)); }
+    void minus_expression::link(scope &scp) const { c_xpr->link(scp); }
+    uint32_t minus_expression::compile(program &p) const { return p.emit(opcode::minus, this, {c_xpr->compile(p)}); }
+    expr not_expression::evaluate(scope &scp, context &ctx) const { return scp.get_core().fold_negate(c_xpr->evaluate(scp, ctx)); }
+    void not_expression::link(scope &scp) const { c_xpr->link(scp); }
+    uint32_t not_expression::compile(program &p) const { return p.emit(opcode::negate, this, {c_xpr->compile(p)}); }
+
+    expr constructor_expression::evaluate(scope &scp, context &ctx) const
+    {
+        return evaluate(scp, ctx, evaluate_expressions(scp, ctx, c_xprs));
+    }
+    expr constructor_expression::evaluate(scope &scp, context &, std::vector<expr> exprs) const
+    {
+        constructor &c = c_cache.get(scp.get_core().cc_stats, exprs, [this](const std::vector<const type *> &par_types) -> constructor &
+                                     { return c_tp->get_constructor(par_types); });
+        return c.new_instance(std::move(exprs));
+    }
+    void constructor_expression::link(scope &scp) const
+    {
+        c_tp = &resolve_type(scp, instance_type);
+        link_expressions(scp, c_xprs);
     }
+    uint32_t constructor_expression::compile(program &p) const { return p.emit(opcode::new_instance, this, compile_expressions(p, c_xprs)); }
 
     expr eq_expression::evaluate(scope &scp, context &ctx) const
     {
-        expr l = static_cast<const ratio::core::expression &>(*left).evaluate(scp, ctx);
-        expr r = static_cast<const ratio::core::expression &>(*right).evaluate(scp, ctx);
-        return scp.get_core().eq(l, r);
+        expr l = c_left->evaluate(scp, ctx);
+        expr r = c_right->evaluate(scp, ctx);
+        return scp.get_core().fold_eq(l, r);
+    }
+    void eq_expression::link(scope &scp) const
+    {
+        c_left->link(scp);
+        c_right->link(scp);
+    }
+    uint32_t eq_expression::compile(program &p) const
+    {
+        const auto l = c_left->compile(p);
+        const auto r = c_right->compile(p);
+        return p.emit(opcode::eq, this, {l, r});
     }
 
     expr neq_expression::evaluate(scope &scp, context &ctx) const
     {
-        expr l = static_cast<const ratio::core::expression &>(*left).evaluate(scp, ctx);
-        expr r = static_cast<const ratio::core::expression &>(*right).evaluate(scp, ctx);
-        return scp.get_core().negate(scp.get_core().eq(l, r));
+        expr l = c_left->evaluate(scp, ctx);
+        expr r = c_right->evaluate(scp, ctx);
+        return scp.get_core().fold_negate(scp.get_core().fold_eq(l, r));
+    }
+    void neq_expression::link(scope &scp) const
+    {
+        c_left->link(scp);
+        c_right->link(scp);
+    }
+    uint32_t neq_expression::compile(program &p) const
+    {
+        const auto l = c_left->compile(p);
+        const auto r = c_right->compile(p);
+        return p.emit(opcode::neq, this, {l, r});
     }
 
     expr lt_expression::evaluate(scope &scp, context &ctx) const
     {
-        expr l = static_cast<const ratio::core::expression &>(*left).evaluate(scp, ctx);
-        expr r = static_cast<const ratio::core::expression &>(*right).evaluate(scp, ctx);
-        return scp.get_core().lt(l, r);
+        expr l = c_left->evaluate(scp, ctx);
+        expr r = c_right->evaluate(scp, ctx);
+        return scp.get_core().fold_lt(l, r);
+    }
+    void lt_expression::link(scope &scp) const
+    {
+        c_left->link(scp);
+        c_right->link(scp);
+    }
+    uint32_t lt_expression::compile(program &p) const
+    {
+        const auto l = c_left->compile(p);
+        const auto r = c_right->compile(p);
+        return p.emit(opcode::lt, this, {l, r});
     }
 
     expr leq_expression::evaluate(scope &scp, context &ctx) const
     {
-        expr l = static_cast<const ratio::core::expression &>(*left).evaluate(scp, ctx);
-        expr r = static_cast<const ratio::core::expression &>(*right).evaluate(scp, ctx);
-        return scp.get_core().leq(l, r);
+        expr l = c_left->evaluate(scp, ctx);
+        expr r = c_right->evaluate(scp, ctx);
+        return scp.get_core().fold_leq(l, r);
+    }
+    void leq_expression::link(scope &scp) const
+    {
+        c_left->link(scp);
+        c_right->link(scp);
+    }
+    uint32_t leq_expression::compile(program &p) const
+    {
+        const auto l = c_left->compile(p);
+        const auto r = c_right->compile(p);
+        return p.emit(opcode::leq, this, {l, r});
     }
 
     expr geq_expression::evaluate(scope &scp, context &ctx) const
     {
-        expr l = static_cast<const ratio::core::expression &>(*left).evaluate(scp, ctx);
-        expr r = static_cast<const ratio::core::expression &>(*right).evaluate(scp, ctx);
-        return scp.get_core().geq(l, r);
+        expr l = c_left->evaluate(scp, ctx);
+        expr r = c_right->evaluate(scp, ctx);
+        return scp.get_core().fold_geq(l, r);
+    }
+    void geq_expression::link(scope &scp) const
+    {
+        c_left->link(scp);
+        c_right->link(scp);
+    }
+    uint32_t geq_expression::compile(program &p) const
+    {
+        const auto l = c_left->compile(p);
+        const auto r = c_right->compile(p);
+        return p.emit(opcode::geq, this, {l, r});
     }
 
     expr gt_expression::evaluate(scope &scp, context &ctx) const
     {
-        expr l = static_cast<const ratio::core::expression &>(*left).evaluate(scp, ctx);
-        expr r = static_cast<const ratio::core::expression &>(*right).evaluate(scp, ctx);
-        return scp.get_core().gt(l, r);
+        expr l = c_left->evaluate(scp, ctx);
+        expr r = c_right->evaluate(scp, ctx);
+        return scp.get_core().fold_gt(l, r);
+    }
+    void gt_expression::link(scope &scp) const
+    {
+        c_left->link(scp);
+        c_right->link(scp);
+    }
+    uint32_t gt_expression::compile(program &p) const
+    {
+        const auto l = c_left->compile(p);
+        const auto r = c_right->compile(p);
+        return p.emit(opcode::gt, this, {l, r});
     }
 
     expr function_expression::evaluate(scope &scp, context &ctx) const
     {
-        scope *s = &scp;
-        for (const auto &id_tk : ids)
-            s = &s->get_type(id_tk.id);
-
-        std::vector<expr> exprs;
-        std::vector<const type *> par_types;
-        for (const auto &ex : expressions)
-        {
-            expr i = static_cast<const ratio::core::expression &>(*ex).evaluate(scp, ctx);
-            exprs.emplace_back(i);
-            par_types.emplace_back(&i->get_type());
-        }
+        return evaluate(scp, ctx, evaluate_expressions(scp, ctx, c_xprs));
+    }
+    expr function_expression::evaluate(scope &scp, context &ctx, std::vector<expr> exprs) const
+    {
+        scope *s = ids.empty() ? &scp : c_scp;
 
-        if (method &m = s->get_method(function_name.id, par_types); m.get_return_type())
-        {
-            const auto rt = m.get_return_type();
-            if (rt == &scp.get_core().get_type(BOOL_KW))
-                return m.invoke(ctx, std::move(exprs));
-            else if (rt == &scp.get_core().get_type(INT_KW) || rt == &scp.get_core().get_type(REAL_KW) || rt == &scp.get_core().get_type(TIME_KW))
-                return m.invoke(ctx, std::move(exprs));
-            else
-                return m.invoke(ctx, std::move(exprs));
-        }
+        // the overload depends only on the types of the arguments, since the scope of the call is either lexical or resolved once..
+        if (method &m = c_cache.get(scp.get_core().cc_stats, exprs, [this, s](const std::vector<const type *> &par_types) -> method &
+                                    { return s->get_method(function_name.id, par_types); });
+            m.get_return_type())
+            return m.invoke(ctx, std::move(exprs));
         else
             return scp.get_core().new_bool(true);
     }
+    void function_expression::link(scope &scp) const
+    {
+        if (!ids.empty())
+            c_scp = &resolve_type(scp, ids);
+        link_expressions(scp, c_xprs);
+    }
+    uint32_t function_expression::compile(program &p) const { return p.emit(opcode::invoke, this, compile_expressions(p, c_xprs)); }
 
     expr id_expression::evaluate(scope &, context &ctx) const
     {
-        expr c_e = ctx->get(ids.begin()->id);
-        for (auto it = std::next(ids.begin()); it != ids.end(); ++it)
-            c_e = static_cast<complex_item &>(*c_e).get(it->id);
+        expr c_e = ctx->get(c_ids.front());
+        for (auto it = std::next(c_ids.cbegin()); it != c_ids.cend(); ++it)
+            c_e = static_cast<complex_item &>(*c_e).get(*it);
         return c_e;
     }
+    uint32_t id_expression::compile(program &p) const { return p.emit(opcode::get, this); }
 
     expr implication_expression::evaluate(scope &scp, context &ctx) const
     {
-        expr l = static_cast<const ratio::core::expression &>(*left).evaluate(scp, ctx);
-        expr r = static_cast<const ratio::core::expression &>(*right).evaluate(scp, ctx);
-        return scp.get_core().disj({scp.get_core().negate(l), r});
+        expr l = c_left->evaluate(scp, ctx);
+        expr r = c_right->evaluate(scp, ctx);
+        return scp.get_core().fold_disj({scp.get_core().fold_negate(l), r});
+    }
+    void implication_expression::link(scope &scp) const
+    {
+        c_left->link(scp);
+        c_right->link(scp);
+    }
+    uint32_t implication_expression::compile(program &p) const
+    {
+        const auto l = c_left->compile(p);
+        const auto r = c_right->compile(p);
+        return p.emit(opcode::implication, this, {l, r});
     }
 
     expr disjunction_expression::evaluate(scope &scp, context &ctx) const
     {
-        std::vector<expr> exprs;
-        for (const auto &e : expressions)
-            exprs.emplace_back(static_cast<const ratio::core::expression &>(*e).evaluate(scp, ctx));
-        return scp.get_core().disj(exprs);
+        return scp.get_core().fold_disj(evaluate_expressions(scp, ctx, c_xprs));
     }
+    void disjunction_expression::link(scope &scp) const { link_expressions(scp, c_xprs); }
+    uint32_t disjunction_expression::compile(program &p) const { return p.emit(opcode::disj, this, compile_expressions(p, c_xprs)); }
 
     expr conjunction_expression::evaluate(scope &scp, context &ctx) const
     {
-        std::vector<expr> exprs;
-        for (const auto &e : expressions)
-            exprs.emplace_back(static_cast<const ratio::core::expression &>(*e).evaluate(scp, ctx));
-        return scp.get_core().conj(exprs);
+        return scp.get_core().fold_conj(evaluate_expressions(scp, ctx, c_xprs));
     }
+    void conjunction_expression::link(scope &scp) const { link_expressions(scp, c_xprs); }
+    uint32_t conjunction_expression::compile(program &p) const { return p.emit(opcode::conj, this, compile_expressions(p, c_xprs)); }
 
     expr exct_one_expression::evaluate(scope &scp, context &ctx) const
     {
-        std::vector<expr> exprs;
-        for (const auto &e : expressions)
-            exprs.emplace_back(static_cast<const ratio::core::expression &>(*e).evaluate(scp, ctx));
-        return scp.get_core().exct_one(exprs);
+        return scp.get_core().fold_exct_one(evaluate_expressions(scp, ctx, c_xprs));
     }
+    void exct_one_expression::link(scope &scp) const { link_expressions(scp, c_xprs); }
+    uint32_t exct_one_expression::compile(program &p) const { return p.emit(opcode::exct_one, this, compile_expressions(p, c_xprs)); }
 
     expr addition_expression::evaluate(scope &scp, context &ctx) const
     {
-        std::vector<expr> exprs;
-        for (const auto &e : expressions)
-            exprs.emplace_back(static_cast<const ratio::core::expression &>(*e).evaluate(scp, ctx));
-        return scp.get_core().add(exprs);
+        return scp.get_core().fold_add(evaluate_expressions(scp, ctx, c_xprs));
     }
+    void addition_expression::link(scope &scp) const { link_expressions(scp, c_xprs); }
+    uint32_t addition_expression::compile(program &p) const { return p.emit(opcode::add, this, compile_expressions(p, c_xprs)); }
 
     expr subtraction_expression::evaluate(scope &scp, context &ctx) const
     {
-        std::vector<expr> exprs;
-        for (const auto &e : expressions)
-            exprs.emplace_back(static_cast<const ratio::core::expression &>(*e).evaluate(scp, ctx));
-        return scp.get_core().sub(exprs);
+        return scp.get_core().fold_sub(evaluate_expressions(scp, ctx, c_xprs));
     }
+    void subtraction_expression::link(scope &scp) const { link_expressions(scp, c_xprs); }
+    uint32_t subtraction_expression::compile(program &p) const { return p.emit(opcode::sub, this, compile_expressions(p, c_xprs)); }
 
     expr multiplication_expression::evaluate(scope &scp, context &ctx) const
     {
-        std::vector<expr> exprs;
-        for (const auto &e : expressions)
-            exprs.emplace_back(static_cast<const ratio::core::expression &>(*e).evaluate(scp, ctx));
-        return scp.get_core().mult(exprs);
+        return scp.get_core().fold_mult(evaluate_expressions(scp, ctx, c_xprs));
     }
+    void multiplication_expression::link(scope &scp) const { link_expressions(scp, c_xprs); }
+    uint32_t multiplication_expression::compile(program &p) const { return p.emit(opcode::mult, this, compile_expressions(p, c_xprs)); }
 
     expr division_expression::evaluate(scope &scp, context &ctx) const
     {
-        std::vector<expr> exprs;
-        for (const auto &e : expressions)
-            exprs.emplace_back(static_cast<const ratio::core::expression &>(*e).evaluate(scp, ctx));
-        return scp.get_core().div(exprs);
+        return scp.get_core().fold_div(evaluate_expressions(scp, ctx, c_xprs));
     }
+    void division_expression::link(scope &scp) const { link_expressions(scp, c_xprs); }
+    uint32_t division_expression::compile(program &p) const { return p.emit(opcode::div, this, compile_expressions(p, c_xprs)); }
 
     void local_field_statement::execute(scope &scp, context &ctx) const
     {
         for (size_t i = 0; i < names.size(); ++i)
-        {
-            if (xprs[i])
-                ctx->vars.emplace(names[i].id, static_cast<const ratio::core::expression &>(*xprs[i]).evaluate(scp, ctx));
-            else
-            {
-                scope *s = &scp;
-                for (const auto &tp : field_type)
-                    s = &s->get_type(tp.id);
-                type *t = static_cast<type *>(s);
-                if (t->is_primitive())
-                    ctx->vars.emplace(names[i].id, t->new_instance());
-                else if (!t->get_instances().empty())
-                    ctx->vars.emplace(names[i].id, t->new_existential());
-                else
-                    throw inconsistency_exception();
-            }
+            execute(scp, ctx, i, c_xprs[i] ? c_xprs[i]->evaluate(scp, ctx) : nullptr);
+    }
+    void local_field_statement::execute(scope &scp, context &ctx, const size_t &i, expr val) const
+    {
+        if (val)
+            ctx->set(c_names[i], std::move(val));
+        else if (c_tp->is_primitive())
+            ctx->set(c_names[i], c_tp->new_instance());
+        else if (!c_tp->get_instances().empty())
+            ctx->set(c_names[i], c_tp->new_existential());
+        else
+            throw inconsistency_exception();
 
-            if (is_core(scp)) // we create fields for root items..
-                scp.get_core().fields.emplace(names[i].id, std::make_unique<field>(ctx->vars.at(names[i].id)->get_type(), names[i].id, xprs[i]));
-        }
+        if (is_core(scp)) // we create fields for root items..
+            scp.get_core().fields.emplace(names[i].id, std::make_unique<field>(ctx->get(c_names[i])->get_type(), names[i].id, c_xprs[i]));
+    }
+    void local_field_statement::link(scope &scp) const
+    {
+        c_tp = &resolve_type(scp, field_type);
+        link_expressions(scp, c_xprs);
+    }
+    void local_field_statement::compile(program &p) const
+    {
+        for (size_t i = 0; i < names.size(); ++i) // each field is declared before evaluating the next initializer..
+            p.emit(opcode::local_field, this, {c_xprs[i] ? c_xprs[i]->compile(p) : program::no_reg}, static_cast<uint32_t>(i));
     }
 
-    void assignment_statement::execute(scope &scp, context &ctx) const
+    void assignment_statement::execute(scope &scp, context &ctx) const { execute(scp, ctx, {c_xpr->evaluate(scp, ctx)}); }
+    void assignment_statement::execute(scope &, context &ctx, std::vector<expr> exprs) const
     {
-        expr c_e = ctx->get(ids.begin()->id);
-        for (auto it = std::next(ids.begin()); it != ids.end(); ++it)
-            c_e = static_cast<complex_item &>(*c_e).get(it->id);
-        static_cast<complex_item &>(*c_e).vars.emplace(id.id, static_cast<const ratio::core::expression &>(*xpr).evaluate(scp, ctx));
+        expr c_e = ctx->get(c_ids.front());
+        for (auto it = std::next(c_ids.cbegin()); it != c_ids.cend(); ++it)
+            c_e = static_cast<complex_item &>(*c_e).get(*it);
+        static_cast<complex_item &>(*c_e).set_var(c_id, std::move(exprs[0]));
     }
+    void assignment_statement::link(scope &scp) const { c_xpr->link(scp); }
+    void assignment_statement::compile(program &p) const { p.emit(opcode::assign, this, {c_xpr->compile(p)}); }
 
     void expression_statement::execute(scope &scp, context &ctx) const
     {
-        expr be = static_cast<const ratio::core::expression &>(*xpr).evaluate(scp, ctx);
-        scp.get_core().assert_facts({be});
+        scp.get_core().assert_fact(c_xpr->evaluate(scp, ctx));
     }
+    void expression_statement::link(scope &scp) const { c_xpr->link(scp); }
+    void expression_statement::compile(program &p) const { p.emit(opcode::assert_fact, this, {c_xpr->compile(p)}); }
 
     void disjunction_statement::execute(scope &scp, context &ctx) const
+    {
+        execute(scp, ctx, evaluate_expressions(scp, ctx, c_costs));
+    }
+    void disjunction_statement::execute(scope &scp, context &ctx, std::vector<expr> exprs) const
     {
         std::vector<std::unique_ptr<ratio::core::conjunction>> cs;
         cs.reserve(conjunctions.size());
+        const auto c_ctx = capture(ctx); // the conjunctions might be executed after the current invocation, sharing the captured context..
         for (size_t i = 0; i < conjunctions.size(); ++i)
         {
             semitone::rational cost(1);
-            if (conjunction_costs[i])
+            if (const auto &a_xpr = exprs[i])
             { // a cost for the conjunction has been specified..
-                expr a_xpr = static_cast<const ratio::core::expression &>(*conjunction_costs[i]).evaluate(scp, ctx);
                 if (!static_cast<arith_item &>(*a_xpr).get_value().vars.empty())
                     throw std::invalid_argument("invalid disjunct cost: expected a constant..");
                 cost = scp.get_core().arith_value(a_xpr).get_rational();
             }
-            cs.emplace_back(std::make_unique<conjunction>(scp, ctx, cost, conjunctions[i]));
+            cs.emplace_back(std::make_unique<conjunction>(scp, c_ctx, cost, bodies[i]));
         }
 
         scp.get_core().new_disjunction(std::move(cs));
     }
+    void disjunction_statement::link(scope &scp) const
+    { // the conjunctions are executed within the scope of the disjunction..
+        for (size_t i = 0; i < conjunctions.size(); ++i)
+        {
+            link_statements(scp, c_conjs[i]);
+            if (c_costs[i])
+                c_costs[i]->link(scp);
+        }
+
+        if (bodies.empty())
+        { // existing conjunctions might refer to the compiled bodies, hence they are compiled only once..
+            bodies.resize(conjunctions.size());
+            for (size_t i = 0; i < conjunctions.size(); ++i)
+                compile_statements(bodies[i], c_conjs[i]);
+        }
+    }
+    void disjunction_statement::compile(program &p) const { p.emit(opcode::disjunction, this, compile_expressions(p, c_costs)); }
 
     void conjunction_statement::execute(scope &scp, context &ctx) const
     {
-        for (const auto &st : statements)
-            static_cast<const ratio::core::statement &>(*st).execute(scp, ctx);
+        for (const auto &st : c_stmnts)
+            st->execute(scp, ctx);
+    }
+    void conjunction_statement::link(scope &scp) const { link_statements(scp, c_stmnts); }
+    void conjunction_statement::compile(program &p) const
+    {
+        for (const auto &st : c_stmnts)
+            st->compile(p);
     }
 
     void formula_statement::execute(scope &scp, context &ctx) const
+    {
+        execute(scp, ctx, evaluate_expressions(scp, ctx, c_xprs));
+    }
+    void formula_statement::execute(scope &scp, context &ctx, std::vector<expr> exprs) const
     {
         predicate *pred = nullptr;
-        std::unordered_map<std::string, expr> assgnments;
-        if (!formula_scope.empty())
-        { // the scope is explicitely declared..
-            expr c_scope = ctx->get(formula_scope.begin()->id);
-            for (auto it = std::next(formula_scope.begin()); it != formula_scope.end(); ++it)
-                c_scope = static_cast<complex_item &>(*c_scope).get(it->id);
-
-            pred = &c_scope->get_type().get_predicate(predicate_name.id);
-
-            if (enum_item *ee = dynamic_cast<enum_item *>(c_scope.get())) // the scope is an enumerative expression..
-                assgnments.emplace(TAU_KW, ee);
-            else // the scope is a single item..
-                assgnments.emplace(TAU_KW, c_scope);
+        std::vector<symbol> names(c_assn_names);
+        std::vector<std::vector<expr>> columns;
+        columns.reserve(exprs.size() + 1);
+        for (auto &e : exprs)
+            columns.push_back({std::move(e)});
+        if (!c_scope.empty())
+        { // the scope is explicitely declared, either as a single item or as an enumerative expression..
+            expr c_scp = ctx->get(c_scope.front());
+            for (auto it = std::next(c_scope.cbegin()); it != c_scope.cend(); ++it)
+                c_scp = static_cast<complex_item &>(*c_scp).get(*it);
+
+            pred = &c_scp->get_type().get_predicate(predicate_name.id);
+            names.push_back(tau_sym);
+            columns.push_back({std::move(c_scp)});
         }
         else
         { // we inherit the scope..
-            pred = &scp.get_predicate(predicate_name.id);
+            pred = c_pred;
             if (!is_core(pred->get_scope()))
-                assgnments.emplace(TAU_KW, ctx->get(TAU_KW));
-        }
-
-        for (size_t i = 0; i < assignment_names.size(); ++i)
-        {
-            expr e = static_cast<const ratio::core::expression &>(*assignment_values[i]).evaluate(scp, ctx);
-            const type &tt = pred->get_field(assignment_names[i].id).get_type(); // the target type..
-            if (tt.is_assignable_from(e->get_type()))                            // the target type is a superclass of the assignment..
-                assgnments.emplace(assignment_names[i].id, e);
-            else if (e->get_type().is_assignable_from(tt)) // the target type is a subclass of the assignment..
-                if (enum_item *ae = dynamic_cast<enum_item *>(&*e))
-                { // some of the allowed values might be inhibited..
-                    // the allowed values..
-                    auto alwd_vals = scp.get_core().enum_value(*ae);
-                    for (auto ev : alwd_vals)
-                        if (!tt.is_assignable_from(e->get_type())) // the target type is not a superclass of the value..
-                            scp.get_core().remove(e, ev);
-                }
-                else // the evaluated expression is a constant which cannot be assigned to the target type (which is a subclass of the type of the evaluated expression)..
-                    throw inconsistency_exception();
-            else // the evaluated expression is unrelated with the target type (we are probably in the presence of a modeling error!)..
-                throw inconsistency_exception();
-        }
-
-        auto atm = pred->new_instance();
-        auto &c_atm = *static_cast<atom *>(atm.get());
-        c_atm.vars.insert(assgnments.cbegin(), assgnments.cend());
-
-        // we initialize the unassigned atom's fields..
-        std::queue<predicate *> q;
-        q.push(pred);
-        while (!q.empty())
-        {
-            for (const auto &arg : q.front()->get_args())
-                if (!c_atm.vars.count(arg->get_name()))
-                { // the field is uninstantiated..
-                    type &tp = arg->get_type();
-                    c_atm.vars.emplace(arg->get_name(), tp.is_primitive() ? tp.new_instance() : tp.new_existential());
-                }
-            for (const auto &sp : q.front()->get_supertypes())
-                q.push(static_cast<predicate *>(sp));
-            q.pop();
+            {
+                names.push_back(tau_sym);
+                columns.push_back({ctx->get(tau_sym)});
+            }
         }
 
-        scp.get_core().new_atom(c_atm, is_fact);
-        ctx->vars.emplace(formula_name.id, atm);
+        ctx->set(c_name, scp.get_core().instantiate_atoms(*pred, 1, names, columns, is_fact).front());
     }
+    void formula_statement::link(scope &scp) const
+    {
+        if (formula_scope.empty()) // the predicate of a formula with an explicit scope depends on the type of the scope, hence it is resolved at execution time..
+            c_pred = &scp.get_predicate(predicate_name.id);
+        link_expressions(scp, c_xprs);
+    }
+    void formula_statement::compile(program &p) const { p.emit(opcode::formula, this, compile_expressions(p, c_xprs)); }
 
-    void return_statement::execute(scope &scp, context &ctx) const { ctx->vars.emplace(RETURN_KW, static_cast<const ratio::core::expression &>(*xpr).evaluate(scp, ctx)); }
+    void return_statement::execute(scope &scp, context &ctx) const { ctx->set(return_sym, c_xpr->evaluate(scp, ctx)); }
+    void return_statement::execute(scope &, context &ctx, std::vector<expr> exprs) const { ctx->set(return_sym, std::move(exprs[0])); }
+    void return_statement::link(scope &scp) const { c_xpr->link(scp); }
+    void return_statement::compile(program &p) const { p.emit(opcode::ret, this, {c_xpr->compile(p)}); }
 
     void method_declaration::refine(scope &scp) const
     {
@@ -341,15 +496,24 @@ namespace ratio::core
             args.emplace_back(std::make_unique<field>(*tp, id_tkn.id));
         }
 
-        if (auto m = std::make_unique<method>(scp, rt, name.id, std::move(args), statements); core *c = dynamic_cast<core *>(&scp))
+        if (auto m = std::make_unique<method>(scp, rt, name.id, std::move(args), c_stmnts); core *c = dynamic_cast<core *>(&scp))
             c->new_method(std::move(m));
         else if (type *t = static_cast<type *>(&scp))
             t->new_method(std::move(m));
     }
+    void method_declaration::link(scope &scp) const
+    {
+        link_statements(scp, c_stmnts);
+        compile_statements(body, c_stmnts);
+        if (const auto at_m = scp.get_methods().find(name.id); at_m != scp.get_methods().cend())
+            for (const auto &m : at_m->second)
+                if (m->statements == &c_stmnts)
+                    m->body = &body;
+    }
 
     void predicate_declaration::declare(scope &scp) const
     {
-        auto p = std::make_unique<predicate>(scp, name.id, std::vector<field_ptr>(), statements);
+        auto p = std::make_unique<predicate>(scp, name.id, std::vector<field_ptr>(), c_stmnts);
         if (core *c = dynamic_cast<core *>(&scp))
             c->new_predicate(std::move(p));
         else if (type *t = static_cast<type *>(&scp))
@@ -379,16 +543,23 @@ namespace ratio::core
             p.new_supertype(*static_cast<predicate *>(s));
         }
     }
+    void predicate_declaration::link(scope &scp) const
+    {
+        link_statements(scp, c_stmnts);
+        compile_statements(body, c_stmnts);
+        scp.get_predicate(name.id).body = &body;
+    }
 
     void typedef_declaration::declare(scope &scp) const
     { // A new typedef type has been declared..
-        auto td = std::make_unique<typedef_type>(scp, name.id, scp.get_type(primitive_type.id), xpr);
+        auto td = std::make_unique<typedef_type>(scp, name.id, scp.get_type(primitive_type.id), *c_xpr);
 
         if (core *c = dynamic_cast<core *>(&scp))
             c->new_type(std::move(td));
         else if (type *t = static_cast<type *>(&scp))
             t->new_type(std::move(td));
     }
+    void typedef_declaration::link(scope &scp) const { c_xpr->link(scp.get_core()); } // typedef expressions are evaluated within the core..
 
     void enum_declaration::declare(scope &scp) const
     {
@@ -397,7 +568,7 @@ namespace ratio::core
 
         // We add the enum values..
         for (const auto &e : enums)
-            et->instances.emplace_back(scp.get_core().new_string(e.str));
+            et->instances.emplace_back(scp.get_core().new_item<string_item>(scp.get_core().get_string_type(), e.str)); // the instances of the enum are not shared with the string literals..
 
         if (core *c = dynamic_cast<core *>(&scp))
             c->new_type(std::move(et));
@@ -428,7 +599,16 @@ namespace ratio::core
         type *tp = static_cast<type *>(s);
 
         for (const auto &vd : declarations)
-            scp.new_field(std::make_unique<field>(*tp, static_cast<const variable_declaration &>(*vd).name.id, static_cast<const variable_declaration &>(*vd).xpr));
+        {
+            const auto &c_vd = static_cast<const variable_declaration &>(*vd);
+            scp.new_field(std::make_unique<field>(*tp, c_vd.name.id, c_vd.c_xpr));
+        }
+    }
+    void field_declaration::link(scope &scp) const
+    {
+        for (const auto &vd : declarations)
+            if (const auto xpr = static_cast<const variable_declaration &>(*vd).c_xpr)
+                xpr->link(scp);
     }
 
     void constructor_declaration::refine(scope &scp) const
@@ -443,23 +623,34 @@ namespace ratio::core
             args.emplace_back(std::make_unique<field>(*tp, id_tkn.id));
         }
 
-        static_cast<type &>(scp).new_constructor(std::make_unique<constructor>(static_cast<type &>(scp), std::move(args), init_names, init_vals, statements));
+        static_cast<type &>(scp).new_constructor(std::make_unique<constructor>(static_cast<type &>(scp), std::move(args), c_init_names, c_init_vals, c_stmnts));
+    }
+    void constructor_declaration::link(scope &scp) const
+    {
+        for (const auto &ivs : c_init_vals)
+            link_expressions(scp, ivs);
+        link_statements(scp, c_stmnts);
+        compile_statements(body, c_stmnts);
+        for (const auto &c : static_cast<type &>(scp).get_constructors())
+            if (c->statements == &c_stmnts)
+                c->body = &body;
     }
 
     void class_declaration::declare(scope &scp) const
     { // A new type has been declared..
         auto tp = std::make_unique<type>(scp, name.id);
+        type &c_tp = *tp;
 
         if (core *c = dynamic_cast<core *>(&scp))
             c->new_type(std::move(tp));
         else if (type *t = static_cast<type *>(&scp))
             t->new_type(std::move(tp));
 
-        for (const auto &c_tp : types)
-            static_cast<const ratio::core::type_declaration &>(*c_tp).declare(*tp);
+        for (const auto &t : c_types)
+            t->declare(c_tp);
 
-        for (const auto &c_p : predicates)
-            static_cast<const ratio::core::predicate_declaration &>(*c_p).declare(*tp);
+        for (const auto &p : predicates)
+            static_cast<const ratio::core::predicate_declaration &>(*p).declare(c_tp);
     }
     void class_declaration::refine(scope &scp) const
     {
@@ -475,8 +666,13 @@ namespace ratio::core
         for (const auto &f : fields)
             static_cast<const ratio::core::field_declaration &>(*f).refine(tp);
 
-        if (constructors.empty()) // we add a default constructor..
-            tp.new_constructor(std::make_unique<constructor>(tp, std::vector<field_ptr>(), std::vector<riddle::id_token>(), std::vector<std::vector<std::unique_ptr<const riddle::ast::expression>>>(), std::vector<std::unique_ptr<const riddle::ast::statement>>()));
+        if (constructors.empty())
+        { // we add a default constructor..
+            static const std::vector<symbol> no_init_names;
+            static const std::vector<std::vector<const ratio::core::expression *>> no_init_vals;
+            static const std::vector<const ratio::core::statement *> no_statements;
+            tp.new_constructor(std::make_unique<constructor>(tp, std::vector<field_ptr>(), no_init_names, no_init_vals, no_statements));
+        }
         else
             for (const auto &c : constructors)
                 static_cast<const ratio::core::constructor_declaration &>(*c).refine(tp);
@@ -485,30 +681,301 @@ namespace ratio::core
             static_cast<const ratio::core::method_declaration &>(*m).refine(tp);
         for (const auto &p : predicates)
             static_cast<const ratio::core::predicate_declaration &>(*p).refine(tp);
-        for (const auto &t : types)
-            static_cast<const ratio::core::type_declaration &>(*t).refine(tp);
+        for (const auto &t : c_types)
+            t->refine(tp);
+    }
+    void class_declaration::link(scope &scp) const
+    { // the bodies declared within a type resolve their references as the type does..
+        type &tp = scp.get_type(name.id);
+        for (const auto &f : fields)
+            static_cast<const ratio::core::field_declaration &>(*f).link(tp);
+        for (const auto &c : constructors)
+            static_cast<const ratio::core::constructor_declaration &>(*c).link(tp);
+        for (const auto &m : methods)
+            static_cast<const ratio::core::method_declaration &>(*m).link(tp);
+        for (const auto &p : predicates)
+            static_cast<const ratio::core::predicate_declaration &>(*p).link(tp);
+        for (const auto &t : c_types)
+            t->link(tp);
     }
 
     void compilation_unit::declare(scope &scp) const
     {
-        for (const auto &t : types)
-            static_cast<const ratio::core::type_declaration &>(*t).declare(scp);
+        for (const auto &t : c_types)
+            t->declare(scp);
+        for (const auto &p : predicates)
+            static_cast<const ratio::core::predicate_declaration &>(*p).declare(scp);
     }
     void compilation_unit::refine(scope &scp) const
     {
-        for (const auto &t : types)
-            static_cast<const ratio::core::type_declaration &>(*t).refine(scp);
+        for (const auto &t : c_types)
+            t->refine(scp);
         for (const auto &m : methods)
             static_cast<const ratio::core::method_declaration &>(*m).refine(scp);
         for (const auto &p : predicates)
             static_cast<const ratio::core::predicate_declaration &>(*p).refine(scp);
     }
+    void compilation_unit::link(scope &scp) const
+    {
+        for (const auto &t : c_types)
+            t->link(scp);
+        for (const auto &m : methods)
+            static_cast<const ratio::core::method_declaration &>(*m).link(scp);
+        for (const auto &p : predicates)
+            static_cast<const ratio::core::predicate_declaration &>(*p).link(scp);
+        link_statements(scp, c_stmnts);
+    }
     void compilation_unit::execute(scope &scp, context &ctx) const
     {
         try
         {
-            for (const auto &stmnt : statements)
-                static_cast<const ratio::core::statement &>(*stmnt).execute(scp, ctx);
+            fact_batch batch(scp.get_core());
+            for (const auto &stmnt : c_stmnts)
+                stmnt->execute(scp, ctx);
+            batch.flush();
+        }
+        catch (const inconsistency_exception &)
+        { // we found an inconsistency at root-level..
+            throw unsolvable_exception();
+        }
+    }
+    bool compilation_unit::retains_statements() const noexcept
+    { // conjunctions, also within disjunctions, refer to the statements of their bodies..
+        return std::any_of(statements.cbegin(), statements.cend(), [](const auto &stmnt)
+                           { return dynamic_cast<const riddle::ast::disjunction_statement *>(stmnt.get()) || dynamic_cast<const riddle::ast::conjunction_statement *>(stmnt.get()); });
+    }
+
+    bool retains_statements(const std::vector<std::unique_ptr<const riddle::ast::method_declaration>> &ms, const std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> &ps, const std::vector<std::unique_ptr<const riddle::ast::type_declaration>> &ts) noexcept
+    {
+        return std::any_of(ms.cbegin(), ms.cend(), [](const auto &m)
+                           { return static_cast<const method_declaration &>(*m).retains_statements(); }) ||
+               std::any_of(ps.cbegin(), ps.cend(), [](const auto &p)
+                           { return static_cast<const predicate_declaration &>(*p).retains_statements(); }) ||
+               std::any_of(ts.cbegin(), ts.cend(), [](const auto &t)
+                           { return dynamic_cast<const type_declaration &>(*t).retains_statements(); });
+    }
+    bool class_declaration::retains_statements() const noexcept
+    {
+        return std::any_of(constructors.cbegin(), constructors.cend(), [](const auto &c)
+                           { return static_cast<const constructor_declaration &>(*c).retains_statements(); }) ||
+               ratio::core::retains_statements(methods, predicates, types);
+    }
+    bool compilation_unit::retains_nodes() const noexcept { return retains_statements() || ratio::core::retains_statements(methods, predicates, types); }
+
+    template <typename Fn>
+    std::string to_bytes(const Fn &fn)
+    {
+        std::ostringstream os;
+        ast_writer w(os, false); // the positions are irrelevant, so that declarations moved within the file compare equal..
+        fn(w);
+        return os.str();
+    }
+
+    const method_declaration *find_method(const std::vector<std::unique_ptr<const riddle::ast::method_declaration>> &ms, const std::string &signature)
+    {
+        for (const auto &m : ms)
+            if (static_cast<const method_declaration &>(*m).get_signature() == signature)
+                return &static_cast<const method_declaration &>(*m);
+        return nullptr;
+    }
+    const predicate_declaration *find_predicate(const std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> &ps, const std::string &name)
+    {
+        for (const auto &p : ps)
+            if (static_cast<const predicate_declaration &>(*p).get_name() == name)
+                return &static_cast<const predicate_declaration &>(*p);
+        return nullptr;
+    }
+    const type_declaration *find_type(const std::vector<std::unique_ptr<const riddle::ast::type_declaration>> &ts, const std::string &name)
+    {
+        for (const auto &t : ts)
+            if (dynamic_cast<const type_declaration &>(*t).get_name() == name)
+                return &dynamic_cast<const type_declaration &>(*t);
+        return nullptr;
+    }
+
+    bool is_reloadable(const std::vector<std::unique_ptr<const riddle::ast::method_declaration>> &ms, const std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> &ps, const std::vector<std::unique_ptr<const riddle::ast::type_declaration>> &ts, const std::vector<std::unique_ptr<const riddle::ast::method_declaration>> &old_ms, const std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> &old_ps, const std::vector<std::unique_ptr<const riddle::ast::type_declaration>> &old_ts)
+    { // every old declaration must have a reloadable counterpart..
+        for (const auto &old_m : old_ms)
+        {
+            const auto &c_old_m = static_cast<const method_declaration &>(*old_m);
+            if (const auto m = find_method(ms, c_old_m.get_signature()); !m || !m->is_reloadable(c_old_m))
+                return false;
+        }
+        for (const auto &old_p : old_ps)
+        {
+            const auto &c_old_p = static_cast<const predicate_declaration &>(*old_p);
+            if (const auto p = find_predicate(ps, c_old_p.get_name()); !p || !p->is_reloadable(c_old_p))
+                return false;
+        }
+        for (const auto &old_t : old_ts)
+        {
+            const auto &c_old_t = dynamic_cast<const type_declaration &>(*old_t);
+            if (const auto t = find_type(ts, c_old_t.get_name()); !t || !t->is_reloadable(c_old_t))
+                return false;
+        }
+        return true;
+    }
+
+    void reload(scope &scp, const std::vector<std::unique_ptr<const riddle::ast::method_declaration>> &ms, const std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> &ps, const std::vector<std::unique_ptr<const riddle::ast::type_declaration>> &ts, const std::vector<std::unique_ptr<const riddle::ast::method_declaration>> &old_ms, const std::vector<std::unique_ptr<const riddle::ast::predicate_declaration>> &old_ps, const std::vector<std::unique_ptr<const riddle::ast::type_declaration>> &old_ts)
+    {
+        // we declare the new types and predicates..
+        for (const auto &t : ts)
+            if (const auto &c_t = dynamic_cast<const type_declaration &>(*t); !find_type(old_ts, c_t.get_name()))
+                c_t.declare(scp);
+        for (const auto &p : ps)
+            if (const auto &c_p = static_cast<const predicate_declaration &>(*p); !find_predicate(old_ps, c_p.get_name()))
+                c_p.declare(scp);
+
+        // we refine the new declarations and reload the existing ones..
+        for (const auto &t : ts)
+            if (const auto &c_t = dynamic_cast<const type_declaration &>(*t); const auto old_t = find_type(old_ts, c_t.get_name()))
+                c_t.reload(scp, *old_t);
+            else
+                c_t.refine(scp);
+        for (const auto &m : ms)
+            if (const auto &c_m = static_cast<const method_declaration &>(*m); const auto old_m = find_method(old_ms, c_m.get_signature()))
+                c_m.reload(scp, *old_m);
+            else
+                c_m.refine(scp);
+        for (const auto &p : ps)
+            if (const auto &c_p = static_cast<const predicate_declaration &>(*p); const auto old_p = find_predicate(old_ps, c_p.get_name()))
+                c_p.reload(scp, *old_p);
+            else
+                c_p.refine(scp);
+    }
+
+    bool type_declaration::is_reloadable(const type_declaration &old) const
+    { // typedefs and enums are reloadable only if unchanged..
+        return to_bytes([this](ast_writer &w)
+                        { write(w); }) == to_bytes([&old](ast_writer &w)
+                                                   { old.write(w); });
+    }
+    void typedef_declaration::reload(scope &scp, const ratio::core::type_declaration &) const { static_cast<typedef_type &>(scp.get_type(name.id)).xpr = c_xpr; } // we rebind the expression of the typedef..
+
+    void field_declaration::reload(scope &scp) const
+    { // we rebind the initialization expressions of the fields..
+        for (const auto &vd : declarations)
+        {
+            const auto &c_vd = static_cast<const variable_declaration &>(*vd);
+            scp.get_fields().at(c_vd.name.id)->xpr = c_vd.c_xpr;
+        }
+    }
+
+    std::string method_declaration::get_signature() const
+    {
+        return to_bytes([this](ast_writer &w)
+                        { w.write_id(name);
+                          w.write_parameters(parameters); });
+    }
+    bool method_declaration::is_reloadable(const method_declaration &old) const
+    {
+        return to_bytes([this](ast_writer &w)
+                        { w.write_ids(return_type); }) == to_bytes([&old](ast_writer &w)
+                                                                   { w.write_ids(old.return_type); });
+    }
+    void method_declaration::reload(scope &scp, const method_declaration &old) const
+    { // we rebind the body of the method..
+        if (const auto at_m = scp.get_methods().find(name.id); at_m != scp.get_methods().cend())
+            for (const auto &m : at_m->second)
+                if (m->statements == &old.c_stmnts)
+                    m->statements = &c_stmnts;
+    }
+
+    bool predicate_declaration::is_reloadable(const predicate_declaration &old) const
+    {
+        return to_bytes([this](ast_writer &w)
+                        { w.write_parameters(parameters);
+                          w.write_paths(predicate_list); }) == to_bytes([&old](ast_writer &w)
+                                                                        { w.write_parameters(old.parameters);
+                                                                          w.write_paths(old.predicate_list); });
+    }
+    void predicate_declaration::reload(scope &scp, const predicate_declaration &) const { scp.get_predicate(name.id).statements = &c_stmnts; } // we rebind the body of the predicate..
+
+    std::string constructor_declaration::get_signature() const
+    {
+        return to_bytes([this](ast_writer &w)
+                        { w.write_parameters(parameters); });
+    }
+    void constructor_declaration::reload(type &tp, const constructor_declaration &old) const
+    { // we rebind the init-list and the body of the constructor..
+        for (const auto &c : tp.get_constructors())
+            if (c->statements == &old.c_stmnts)
+            {
+                c->init_names = &c_init_names;
+                c->init_vals = &c_init_vals;
+                c->statements = &c_stmnts;
+                c->init_caches = std::vector<call_cache<constructor>>(init_names.size());
+            }
+    }
+
+    bool class_declaration::is_reloadable(const ratio::core::type_declaration &old) const
+    {
+        const auto c_old = dynamic_cast<const class_declaration *>(&old);
+        if (!c_old) // the type is no more a class..
+            return false;
+
+        // the base classes and the fields must be unchanged..
+        if (to_bytes([this](ast_writer &w)
+                     { w.write_paths(base_classes);
+                       for (const auto &f : fields)
+                           static_cast<const ratio::core::field_declaration &>(*f).write(w); }) != to_bytes([c_old](ast_writer &w)
+                                                                                                            { w.write_paths(c_old->base_classes);
+                                                                                                              for (const auto &f : c_old->fields)
+                                                                                                                  static_cast<const ratio::core::field_declaration &>(*f).write(w); }))
+            return false;
+
+        // the constructors must have the same signatures..
+        if (constructors.size() != c_old->constructors.size())
+            return false;
+        for (const auto &old_c : c_old->constructors)
+            if (std::none_of(constructors.cbegin(), constructors.cend(), [sgn = static_cast<const constructor_declaration &>(*old_c).get_signature()](const auto &c)
+                             { return static_cast<const constructor_declaration &>(*c).get_signature() == sgn; }))
+                return false;
+
+        return ratio::core::is_reloadable(methods, predicates, types, c_old->methods, c_old->predicates, c_old->types);
+    }
+    void class_declaration::reload(scope &scp, const ratio::core::type_declaration &old) const
+    {
+        const auto &c_old = static_cast<const class_declaration &>(old);
+        type &tp = scp.get_type(name.id);
+        for (const auto &c : constructors)
+        {
+            const auto &c_c = static_cast<const constructor_declaration &>(*c);
+            for (const auto &old_c : c_old.constructors)
+                if (const auto &c_old_c = static_cast<const constructor_declaration &>(*old_c); c_old_c.get_signature() == c_c.get_signature())
+                    c_c.reload(tp, c_old_c);
+        }
+        for (const auto &f : fields)
+            static_cast<const ratio::core::field_declaration &>(*f).reload(tp);
+        ratio::core::reload(tp, methods, predicates, types, c_old.methods, c_old.predicates, c_old.types);
+    }
+
+    bool compilation_unit::is_reloadable(const compilation_unit &old) const
+    {
+        if (!ratio::core::is_reloadable(methods, predicates, types, old.methods, old.predicates, old.types))
+            return false;
+
+        // the old statements must be a prefix of the new ones..
+        if (statements.size() < old.statements.size())
+            return false;
+        for (size_t i = 0; i < old.statements.size(); ++i)
+            if (to_bytes([this, i](ast_writer &w)
+                         { w.write_statement(statements[i]); }) != to_bytes([&old, i](ast_writer &w)
+                                                                            { w.write_statement(old.statements[i]); }))
+                return false;
+        return true;
+    }
+    void compilation_unit::reload(scope &scp, context &ctx, const compilation_unit &old) const
+    {
+        ratio::core::reload(scp, methods, predicates, types, old.methods, old.predicates, old.types);
+        link(scp);
+
+        try
+        { // we execute the appended statements..
+            fact_batch batch(scp.get_core());
+            for (size_t i = old.statements.size(); i < statements.size(); ++i)
+                c_stmnts[i]->execute(scp, ctx);
+            batch.flush();
         }
         catch (const inconsistency_exception &)
         { // we found an inconsistency at root-level..
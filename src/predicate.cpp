@@ -1,12 +1,12 @@
 #include "predicate.h"
+#include "core.h"
 #include "atom.h"
 #include "field.h"
 #include "parser.h"
-#include <queue>
 
 namespace ratio::core
 {
-    RATIOCORE_EXPORT predicate::predicate(scope &scp, const std::string &name, std::vector<field_ptr> args, const std::vector<std::unique_ptr<const riddle::ast::statement>> &stmnts) : type(scp, name), statements(stmnts)
+    RATIOCORE_EXPORT predicate::predicate(scope &scp, const std::string &name, std::vector<field_ptr> args, const std::vector<const statement *> &stmnts) : type(scp, name), statements(&stmnts)
     {
         this->args.reserve(args.size());
         for (auto &f : args)
@@ -18,35 +18,46 @@ namespace ratio::core
 
     RATIOCORE_EXPORT expr predicate::new_instance()
     {
-        auto itm = std::make_shared<atom>(*this);
+        auto itm = get_core().new_item<atom>(*this);
         // we add the new atom to the instances of this predicate and to the instances of all the super-predicates..
-        std::queue<type *> q;
-        q.push(this);
-        while (!q.empty())
-        {
-            q.front()->instances.push_back(itm);
-            for (const auto &st : q.front()->supertypes)
-                q.push(st);
-            q.pop();
-        }
+        for (const auto &at : get_ancestors())
+            at->instances.push_back(itm);
         return itm;
     }
 
+    RATIOCORE_EXPORT std::vector<expr> predicate::new_instances(const size_t &n)
+    {
+        std::vector<expr> itms;
+        itms.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            itms.emplace_back(get_core().new_item<atom>(*this));
+        // we add the new atoms to the instances of this predicate and to the instances of all the super-predicates..
+        for (const auto &at : get_ancestors())
+            at->instances.insert(at->instances.cend(), itms.cbegin(), itms.cend());
+        return itms;
+    }
+
     RATIOCORE_EXPORT void predicate::apply_rule(atom &a)
     {
         for (const auto &sp : supertypes)
             if (auto p = dynamic_cast<predicate *>(sp))
                 p->apply_rule(a);
 
-        auto ctx = std::make_shared<env>(a);
-        ctx->vars.emplace(THIS_KW, &a);
-        for (const auto &s : statements)
-            dynamic_cast<const statement &>(*s).execute(*this, ctx);
+        frame frm(a);
+        auto ctx = frm.get_context();
+        ctx->set(this_sym, borrow(a));
+        fact_batch batch(get_core());
+        if (body)
+            body->run(*this, ctx);
+        else
+            for (const auto &s : *statements)
+                s->execute(*this, ctx);
+        batch.flush();
     }
 
     RATIOCORE_EXPORT void predicate::new_field(field_ptr f) noexcept
     {
         args.push_back(f.get());
-        scope::new_field(std::move(f));
+        type::new_field(std::move(f));
     }
 } // namespace ratio::core
@@ -0,0 +1,133 @@
+#include "program.h"
+#include "core.h"
+#include "parser.h"
+#include <algorithm>
+
+namespace ratio::core
+{
+    RATIOCORE_EXPORT uint32_t program::emit(const opcode &op, const void *node, const std::vector<uint32_t> &c_ops, const uint32_t &arg)
+    {
+        code.push_back({op, n_regs, static_cast<uint32_t>(ops.size()), static_cast<uint32_t>(c_ops.size()), arg, node});
+        ops.insert(ops.cend(), c_ops.cbegin(), c_ops.cend());
+        return n_regs++;
+    }
+
+    RATIOCORE_EXPORT void program::clear() noexcept
+    {
+        code.clear();
+        ops.clear();
+        n_regs = 0;
+    }
+
+    RATIOCORE_EXPORT bool program::contains(const opcode &op) const noexcept
+    {
+        return std::any_of(code.cbegin(), code.cend(), [&op](const auto &i)
+                           { return i.op == op; });
+    }
+
+    RATIOCORE_EXPORT void program::run(scope &scp, context &ctx) const
+    {
+        core &cr = scp.get_core();
+        std::vector<expr> regs(n_regs);
+        for (const auto &i : code)
+            switch (i.op)
+            {
+            case opcode::new_bool:
+                regs[i.dst] = static_cast<const bool_literal_expression *>(i.node)->evaluate(scp, ctx);
+                break;
+            case opcode::new_int:
+                regs[i.dst] = static_cast<const int_literal_expression *>(i.node)->evaluate(scp, ctx);
+                break;
+            case opcode::new_real:
+                regs[i.dst] = static_cast<const real_literal_expression *>(i.node)->evaluate(scp, ctx);
+                break;
+            case opcode::new_string:
+                regs[i.dst] = static_cast<const string_literal_expression *>(i.node)->evaluate(scp, ctx);
+                break;
+            case opcode::get:
+                regs[i.dst] = static_cast<const id_expression *>(i.node)->evaluate(scp, ctx);
+                break;
+            case opcode::minus:
+                regs[i.dst] = cr.fold_minus(regs[ops[i.first]]);
+                break;
+            case opcode::negate:
+                regs[i.dst] = cr.fold_negate(regs[ops[i.first]]);
+                break;
+            case opcode::eq:
+                regs[i.dst] = cr.fold_eq(regs[ops[i.first]], regs[ops[i.first + 1]]);
+                break;
+            case opcode::neq:
+                regs[i.dst] = cr.fold_negate(cr.fold_eq(regs[ops[i.first]], regs[ops[i.first + 1]]));
+                break;
+            case opcode::lt:
+                regs[i.dst] = cr.fold_lt(regs[ops[i.first]], regs[ops[i.first + 1]]);
+                break;
+            case opcode::leq:
+                regs[i.dst] = cr.fold_leq(regs[ops[i.first]], regs[ops[i.first + 1]]);
+                break;
+            case opcode::geq:
+                regs[i.dst] = cr.fold_geq(regs[ops[i.first]], regs[ops[i.first + 1]]);
+                break;
+            case opcode::gt:
+                regs[i.dst] = cr.fold_gt(regs[ops[i.first]], regs[ops[i.first + 1]]);
+                break;
+            case opcode::implication:
+                regs[i.dst] = cr.fold_disj({cr.fold_negate(regs[ops[i.first]]), regs[ops[i.first + 1]]});
+                break;
+            case opcode::disj:
+                regs[i.dst] = cr.fold_disj(get_operands(regs, i));
+                break;
+            case opcode::conj:
+                regs[i.dst] = cr.fold_conj(get_operands(regs, i));
+                break;
+            case opcode::exct_one:
+                regs[i.dst] = cr.fold_exct_one(get_operands(regs, i));
+                break;
+            case opcode::add:
+                regs[i.dst] = cr.fold_add(get_operands(regs, i));
+                break;
+            case opcode::sub:
+                regs[i.dst] = cr.fold_sub(get_operands(regs, i));
+                break;
+            case opcode::mult:
+                regs[i.dst] = cr.fold_mult(get_operands(regs, i));
+                break;
+            case opcode::div:
+                regs[i.dst] = cr.fold_div(get_operands(regs, i));
+                break;
+            case opcode::new_instance:
+                regs[i.dst] = static_cast<const constructor_expression *>(i.node)->evaluate(scp, ctx, get_operands(regs, i));
+                break;
+            case opcode::invoke:
+                regs[i.dst] = static_cast<const function_expression *>(i.node)->evaluate(scp, ctx, get_operands(regs, i));
+                break;
+            case opcode::local_field:
+                static_cast<const local_field_statement *>(i.node)->execute(scp, ctx, i.arg, ops[i.first] == no_reg ? nullptr : regs[ops[i.first]]);
+                break;
+            case opcode::assign:
+                static_cast<const assignment_statement *>(i.node)->execute(scp, ctx, get_operands(regs, i));
+                break;
+            case opcode::assert_fact:
+                cr.assert_fact(regs[ops[i.first]]);
+                break;
+            case opcode::disjunction:
+                static_cast<const disjunction_statement *>(i.node)->execute(scp, ctx, get_operands(regs, i));
+                break;
+            case opcode::formula:
+                static_cast<const formula_statement *>(i.node)->execute(scp, ctx, get_operands(regs, i));
+                break;
+            case opcode::ret:
+                static_cast<const return_statement *>(i.node)->execute(scp, ctx, get_operands(regs, i));
+                break;
+            }
+    }
+
+    std::vector<expr> program::get_operands(const std::vector<expr> &regs, const instruction &i) const
+    {
+        std::vector<expr> c_ops;
+        c_ops.reserve(i.count);
+        for (uint32_t j = i.first; j < i.first + i.count; ++j)
+            c_ops.emplace_back(ops[j] == no_reg ? nullptr : regs[ops[j]]);
+        return c_ops;
+    }
+} // namespace ratio::core
@@ -1,5 +1,6 @@
 #include "scope.h"
 #include "field.h"
+#include <stdexcept>
 
 namespace ratio::core
 {
@@ -8,21 +9,45 @@ namespace ratio::core
 
     RATIOCORE_EXPORT void scope::new_field(field_ptr f) { fields.emplace(f->get_name(), std::move(f)); }
 
-    RATIOCORE_EXPORT const field &scope::get_field(const std::string &name) const
+    RATIOCORE_EXPORT const field *scope::find_field(const std::string &name) const noexcept
     {
         if (const auto at_f = fields.find(name); at_f != fields.cend())
-            return *at_f->second;
+            return at_f->second.get();
 
         // if not here, check any enclosing scope
-        return scp.get_field(name);
+        return scp.find_field(name);
+    }
+    RATIOCORE_EXPORT const field &scope::get_field(const std::string &name) const
+    {
+        if (const auto f = find_field(name))
+            return *f;
+        throw std::out_of_range(name);
     }
 
-    RATIOCORE_EXPORT method &scope::get_method(const std::string &name, const std::vector<const type *> &ts) const { return scp.get_method(name, ts); }
+    RATIOCORE_EXPORT method *scope::find_method(const std::string &name, const std::vector<const type *> &ts) const noexcept { return scp.find_method(name, ts); }
+    RATIOCORE_EXPORT method &scope::get_method(const std::string &name, const std::vector<const type *> &ts) const
+    {
+        if (const auto m = find_method(name, ts))
+            return *m;
+        throw std::out_of_range(name);
+    }
     RATIOCORE_EXPORT const std::map<std::string, std::vector<method_ptr>> &scope::get_methods() const noexcept { return scp.get_methods(); }
 
-    RATIOCORE_EXPORT type &scope::get_type(const std::string &name) const { return scp.get_type(name); }
+    RATIOCORE_EXPORT type *scope::find_type(const std::string &name) const noexcept { return scp.find_type(name); }
+    RATIOCORE_EXPORT type &scope::get_type(const std::string &name) const
+    {
+        if (const auto t = find_type(name))
+            return *t;
+        throw std::out_of_range(name);
+    }
     RATIOCORE_EXPORT const std::map<std::string, type_ptr> &scope::get_types() const noexcept { return scp.get_types(); }
 
-    RATIOCORE_EXPORT predicate &scope::get_predicate(const std::string &name) const { return scp.get_predicate(name); }
+    RATIOCORE_EXPORT predicate *scope::find_predicate(const std::string &name) const noexcept { return scp.find_predicate(name); }
+    RATIOCORE_EXPORT predicate &scope::get_predicate(const std::string &name) const
+    {
+        if (const auto p = find_predicate(name))
+            return *p;
+        throw std::out_of_range(name);
+    }
     RATIOCORE_EXPORT const std::map<std::string, predicate_ptr> &scope::get_predicates() const noexcept { return scp.get_predicates(); }
 } // namespace ratio::core
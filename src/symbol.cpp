@@ -0,0 +1,97 @@
+#include "symbol.h"
+#include "core_defs.h"
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+namespace ratio::core
+{
+    RATIOCORE_EXPORT const std::string keyword_names[3] = {THIS_KW, RETURN_KW, TAU_KW};
+
+    /**
+     * The interned names, indexed both by their dense integers and by their text.
+     */
+    class symbol_table
+    {
+    public:
+        symbol_table()
+        { // the keywords are interned in the same order as their predefined symbols, referring to their names as literals since the names might not be constructed yet..
+            by_id = {&keyword_names[0], &keyword_names[1], &keyword_names[2]};
+            ids.emplace(THIS_KW, this_sym);
+            ids.emplace(RETURN_KW, return_sym);
+            ids.emplace(TAU_KW, tau_sym);
+        }
+
+        symbol intern(std::string_view name)
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (const auto at_name = ids.find(name); at_name != ids.cend())
+                return at_name->second;
+            const auto &c_name = names.emplace_back(name); // names are never moved, hence their views and their addresses stay valid..
+            by_id.push_back(&c_name);
+            return ids.emplace(c_name, symbol(static_cast<uint32_t>(by_id.size() - 1), c_name)).first->second;
+        }
+
+        std::optional<symbol> find(std::string_view name) noexcept
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (const auto at_name = ids.find(name); at_name != ids.cend())
+                return at_name->second;
+            return std::nullopt;
+        }
+
+        const std::string &get_name(const uint32_t &id) noexcept
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            return *by_id[id];
+        }
+
+    private:
+        std::mutex mtx;                                   // interning might happen from different parsing threads..
+        std::deque<std::string> names;                    // the interned names, other than the keywords..
+        std::vector<const std::string *> by_id;           // the interned names, indexed by their dense integers..
+        std::unordered_map<std::string_view, symbol> ids; // the symbols, indexed by the interned names..
+    };
+
+    symbol_table &get_symbol_table()
+    {
+        static symbol_table st;
+        return st;
+    }
+
+    /**
+     * Returns the symbols already interned or found by the calling thread, so that looking for them again takes no lock.
+     *
+     * The cached symbols are never stale, since interned names are never removed, and the keys refer to the interned text, which outlives the cache.
+     */
+    std::unordered_map<std::string_view, symbol> &get_thread_symbols()
+    {
+        thread_local std::unordered_map<std::string_view, symbol> syms;
+        return syms;
+    }
+
+    symbol intern(std::string_view name)
+    {
+        auto &syms = get_thread_symbols();
+        if (const auto at_name = syms.find(name); at_name != syms.cend())
+            return at_name->second;
+        const auto sym = get_symbol_table().intern(name);
+        syms.emplace(sym.str(), sym);
+        return sym;
+    }
+
+    RATIOCORE_EXPORT symbol::symbol(std::string_view name) : symbol(intern(name)) {}
+    RATIOCORE_EXPORT symbol::symbol(const uint32_t &id) noexcept : id(id), name(&get_symbol_table().get_name(id)) {}
+
+    RATIOCORE_EXPORT std::optional<symbol> symbol::find(std::string_view name) noexcept
+    {
+        auto &syms = get_thread_symbols();
+        if (const auto at_name = syms.find(name); at_name != syms.cend())
+            return at_name->second;
+        const auto sym = get_symbol_table().find(name);
+        if (sym) // names which have not been interned yet are not cached, since they might be interned later..
+            syms.emplace(sym->str(), *sym);
+        return sym;
+    }
+} // namespace ratio::core
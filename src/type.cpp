@@ -5,50 +5,89 @@
 #include "constructor.h"
 #include "method.h"
 #include "parser.h"
-#include <queue>
 #include <algorithm>
 #include <stdexcept>
 #include <cassert>
 
 namespace ratio::core
 {
-    RATIOCORE_EXPORT type::type(scope &scp, const std::string &name, bool primitive) : scope(scp), name(name), primitive(primitive) {}
+    RATIOCORE_EXPORT type::type(scope &scp, const std::string &name, bool primitive) : scope(scp), name(name), primitive(primitive), id(get_core().n_types++)
+    {
+        add_ancestor(*this);
+        get_core().hierarchy_changed = true; // the new type has to be laid out..
+    }
     RATIOCORE_EXPORT type::~type() {}
 
-    RATIOCORE_EXPORT bool type::is_assignable_from(const type &t) const noexcept
+    RATIOCORE_EXPORT bool type::is_assignable_from(const type &t) const
+    {
+        if (get_core().hierarchy_changed)
+            get_core().encode_hierarchy();
+        return id / 64 < t.ancestors.size() && (t.ancestors[id / 64] >> (id % 64) & 1);
+    }
+
+    void type::add_ancestor(const type &t) noexcept
     {
-        std::queue<const type *> q;
-        q.push(&t);
-        while (!q.empty())
+        if (ancestors.size() <= t.id / 64)
+            ancestors.resize(t.id / 64 + 1, 0);
+        ancestors[t.id / 64] |= uint64_t(1) << (t.id % 64);
+    }
+
+    void type::encode_ancestors(std::vector<bool> &encoded)
+    {
+        if (encoded[id])
+            return;
+        encoded[id] = true;
+
+        ancestors.assign(get_core().n_types / 64 + 1, 0);
+        add_ancestor(*this);
+        ancestor_types.assign(1, this);
+        auto c_layout = std::make_unique<slot_layout>();
+        for (const auto &[f_name, f] : get_fields())
+            c_layout->emplace(f->get_symbol(), f.get());
+        for (const auto &st : supertypes)
         {
-            if (q.front() == this)
-                return true;
-            else
-            {
-                for (const auto &st : q.front()->supertypes)
-                    q.push(st);
-                q.pop();
-            }
+            st->encode_ancestors(encoded);
+            for (const auto &at : st->ancestor_types)
+                if (!(ancestors[at->id / 64] >> (at->id % 64) & 1))
+                { // a new ancestor..
+                    add_ancestor(*at);
+                    ancestor_types.push_back(at);
+                }
+            c_layout->insert(st->layouts.back()->cbegin(), st->layouts.back()->cend()); // the fields of the first supertypes hide those of the following ones..
         }
-        return false;
+        if (layouts.empty() || !std::equal(c_layout->cbegin(), c_layout->cend(), layouts.back()->cbegin(), layouts.back()->cend()))
+            layouts.emplace_back(std::move(c_layout));
+    }
+
+    RATIOCORE_EXPORT void type::new_field(field_ptr f)
+    {
+        scope::new_field(std::move(f));
+        get_core().hierarchy_changed = true; // the flattened field tables of this type and of its subtypes are stale..
+    }
+
+    RATIOCORE_EXPORT const std::vector<type *> &type::get_ancestors() const
+    {
+        if (get_core().hierarchy_changed)
+            get_core().encode_hierarchy();
+        return ancestor_types;
     }
 
     RATIOCORE_EXPORT expr type::new_instance()
     {
-        auto itm = std::make_shared<complex_item>(*this);
-        // we add the new item to the instances of this predicate and to the instances of all the super-predicates..
-        std::queue<type *> q;
-        q.push(this);
-        while (!q.empty())
-        {
-            q.front()->instances.push_back(itm);
-            for (const auto &st : q.front()->supertypes)
-                q.push(st);
-            q.pop();
-        }
+        auto itm = get_core().new_item<complex_item>(*this);
+        // we add the new item to the instances of this type and to the instances of all the supertypes..
+        for (const auto &at : get_ancestors())
+            at->instances.push_back(itm);
         return itm;
     }
 
+    RATIOCORE_EXPORT domain type::get_domain() const noexcept
+    {
+        if (!c_domain || c_domain->size() != instances.size()) // instances are never removed, hence the size of a snapshot tells whether it is stale..
+            c_domain = std::make_shared<const std::vector<expr>>(instances);
+        return c_domain;
+    }
+
     RATIOCORE_EXPORT expr type::new_existential()
     {
         switch (instances.size())
@@ -58,21 +97,30 @@ namespace ratio::core
         case 1:
             return *instances.cbegin();
         default:
-            std::vector<expr> c_vals;
-            c_vals.reserve(instances.size());
-            for (const auto &i : instances)
-                c_vals.push_back(i);
-            return get_core().new_enum(*this, c_vals);
+            return get_core().new_enum(*this, get_domain());
         }
     }
 
-    RATIOCORE_EXPORT void type::new_supertype(type &t) noexcept { supertypes.emplace_back(&t); }
-    RATIOCORE_EXPORT void type::new_constructor(constructor_ptr c) noexcept { constructors.emplace_back(std::move(c)); }
-    RATIOCORE_EXPORT void type::new_method(method_ptr m) noexcept { methods[m->get_name()].emplace_back(std::move(m)); }
+    RATIOCORE_EXPORT void type::new_supertype(type &t) noexcept
+    {
+        supertypes.emplace_back(&t);
+        get_core().cc_stats.epoch++;         // the new supertype might change the resolution of the cached overloads..
+        get_core().hierarchy_changed = true; // ..and the ancestors of this type and of its subtypes..
+    }
+    RATIOCORE_EXPORT void type::new_constructor(constructor_ptr c) noexcept
+    {
+        constructors.emplace_back(std::move(c));
+        get_core().cc_stats.epoch++;
+    }
+    RATIOCORE_EXPORT void type::new_method(method_ptr m) noexcept
+    {
+        methods[m->get_name()].emplace_back(std::move(m));
+        get_core().cc_stats.epoch++;
+    }
     RATIOCORE_EXPORT void type::new_type(type_ptr t) noexcept { types.emplace(t->get_name(), std::move(t)); }
     RATIOCORE_EXPORT void type::new_predicate(predicate_ptr p) noexcept { predicates.emplace(p->get_name(), std::move(p)); }
 
-    constructor &type::get_constructor(const std::vector<const type *> &ts) const
+    RATIOCORE_EXPORT constructor *type::find_constructor(const std::vector<const type *> &ts) const noexcept
     {
         assert(std::none_of(ts.cbegin(), ts.cend(), [](const type *t)
                             { return t == nullptr; }));
@@ -88,38 +136,51 @@ namespace ratio::core
                         break;
                     }
                 if (found)
-                    return *cnstr;
+                    return cnstr.get();
             }
 
+        // not found
+        return nullptr;
+    }
+    RATIOCORE_EXPORT constructor &type::get_constructor(const std::vector<const type *> &ts) const
+    {
+        if (const auto c = find_constructor(ts))
+            return *c;
         throw std::out_of_range(name);
     }
 
-    RATIOCORE_EXPORT const field &type::get_field(const std::string &name) const
+    RATIOCORE_EXPORT const field *type::find_field(const std::string &name) const noexcept
     {
         if (const auto at_f = get_fields().find(name); at_f != get_fields().cend())
-            return *at_f->second;
+            return at_f->second.get();
 
-        try
-        { // if not here, check any enclosing scope
-            return get_scope().get_field(name);
-        }
-        catch (const std::out_of_range &)
-        { // if not in any enclosing scope, check any superclass
-            for (const auto &st : supertypes)
-                try
-                {
-                    return st->get_field(name);
-                }
-                catch (const std::out_of_range &)
-                {
-                }
-        }
+        // if not here, check any enclosing scope
+        if (const auto f = get_scope().find_field(name))
+            return f;
 
-        // not found
-        throw std::out_of_range(name);
+        // if not in any enclosing scope, check any superclass (a name which has never been interned is not the name of any field)..
+        if (const auto sym = symbol::find(name))
+            return find_inherited_field(*sym);
+        return nullptr;
     }
 
-    RATIOCORE_EXPORT method &type::get_method(const std::string &name, const std::vector<const type *> &ts) const
+    RATIOCORE_EXPORT const field *type::find_inherited_field(const symbol &sym) const noexcept
+    {
+        const auto &layout = get_layout();
+        if (const auto at_f = layout.find(sym); at_f != layout.cend())
+            return at_f->second;
+        return nullptr;
+    }
+
+    RATIOCORE_EXPORT const slot_layout &type::get_layout() const
+    {
+        if (get_core().hierarchy_changed)
+            get_core().encode_hierarchy();
+        assert(!layouts.empty() && "the type is not reachable from its core");
+        return *layouts.back();
+    }
+
+    RATIOCORE_EXPORT method *type::find_method(const std::string &name, const std::vector<const type *> &ts) const noexcept
     {
         if (const auto at_m = methods.find(name); at_m != methods.cend())
         {
@@ -135,127 +196,106 @@ namespace ratio::core
                             break;
                         }
                     if (found)
-                        return *mthd;
+                        return mthd.get();
                 }
         }
 
-        try
-        { // if not here, check any enclosing scope
-            return get_scope().get_method(name, ts);
-        }
-        catch (const std::out_of_range &)
-        { // if not in any enclosing scope, check any superclass
-            for (const auto &st : supertypes)
-            {
-                try
-                {
-                    return st->get_method(name, ts);
-                }
-                catch (const std::out_of_range &)
-                {
-                }
-            }
-        }
+        // if not here, check any enclosing scope
+        if (const auto m = get_scope().find_method(name, ts))
+            return m;
+
+        // if not in any enclosing scope, check any superclass
+        for (const auto &st : supertypes)
+            if (const auto m = st->find_method(name, ts))
+                return m;
 
         // not found
-        throw std::out_of_range(name);
+        return nullptr;
     }
 
-    RATIOCORE_EXPORT type &type::get_type(const std::string &name) const
+    RATIOCORE_EXPORT type *type::find_type(const std::string &name) const noexcept
     {
         if (const auto at_tp = types.find(name); at_tp != types.cend())
-            return *at_tp->second;
+            return at_tp->second.get();
 
-        try
-        { // if not here, check any enclosing scope
-            return get_scope().get_type(name);
-        }
-        catch (const std::out_of_range &)
-        { // if not in any enclosing scope, check any superclass
-            for (const auto &st : supertypes)
-            {
-                try
-                {
-                    return st->get_type(name);
-                }
-                catch (const std::out_of_range &)
-                {
-                }
-            }
-        }
+        // if not here, check any enclosing scope
+        if (const auto t = get_scope().find_type(name))
+            return t;
+
+        // if not in any enclosing scope, check any superclass
+        for (const auto &st : supertypes)
+            if (const auto t = st->find_type(name))
+                return t;
 
         // not found
-        throw std::out_of_range(name);
+        return nullptr;
     }
 
-    RATIOCORE_EXPORT predicate &type::get_predicate(const std::string &name) const
+    RATIOCORE_EXPORT predicate *type::find_predicate(const std::string &name) const noexcept
     {
         if (const auto at_p = predicates.find(name); at_p != predicates.cend())
-            return *at_p->second;
+            return at_p->second.get();
 
-        try
-        { // if not here, check any enclosing scope
-            return get_scope().get_predicate(name);
-        }
-        catch (const std::out_of_range &)
-        { // if not in any enclosing scope, check any superclass
-            for (const auto &st : supertypes)
-            {
-                try
-                {
-                    return st->get_predicate(name);
-                }
-                catch (const std::out_of_range &)
-                {
-                }
-            }
-        }
+        // if not here, check any enclosing scope
+        if (const auto p = get_scope().find_predicate(name))
+            return p;
+
+        // if not in any enclosing scope, check any superclass
+        for (const auto &st : supertypes)
+            if (const auto p = st->find_predicate(name))
+                return p;
 
         // not found
-        throw std::out_of_range(name);
+        return nullptr;
     }
 
     bool_type::bool_type(core &cr) : type(cr, BOOL_KW, true) {}
     expr bool_type::new_instance() noexcept { return nullptr; }
 
     int_type::int_type(core &cr) : type(cr, INT_KW, true) {}
-    bool int_type::is_assignable_from(const type &t) const noexcept { return &t == this || &t == &get_core().get_type(TIME_KW); }
     expr int_type::new_instance() noexcept { return nullptr; }
 
     real_type::real_type(core &cr) : type(cr, REAL_KW, true) {}
-    bool real_type::is_assignable_from(const type &t) const noexcept { return &t == this || &t == &get_core().get_type(TIME_KW); }
     expr real_type::new_instance() noexcept { return nullptr; }
 
     time_type::time_type(core &cr) : type(cr, TIME_KW, true) {}
-    bool time_type::is_assignable_from(const type &t) const noexcept { return &t == this || &t == &get_core().get_type(INT_KW) || &t == &get_core().get_type(REAL_KW); }
     expr time_type::new_instance() noexcept { return nullptr; }
 
     string_type::string_type(core &cr) : type(cr, STRING_KW, true) {}
     expr string_type::new_instance() noexcept { return nullptr; }
 
-    typedef_type::typedef_type(scope &scp, const std::string &name, const type &base_type, const std::unique_ptr<const riddle::ast::expression> &e) : type(scp, name), base_type(base_type), xpr(e) {}
+    typedef_type::typedef_type(scope &scp, const std::string &name, const type &base_type, const expression &e) : type(scp, name), base_type(base_type), xpr(&e) {}
     expr typedef_type::new_instance() noexcept
     {
-        auto ctx = std::make_shared<env>(get_core());
-        return dynamic_cast<const expression &>(*xpr).evaluate(get_core(), ctx);
+        frame frm(get_core());
+        auto ctx = frm.get_context();
+        return xpr->evaluate(get_core(), ctx);
     }
 
     enum_type::enum_type(scope &scp, std::string name) : type(scp, name) {}
 
     expr enum_type::new_instance() { return get_core().new_enum(*this, get_all_instances()); }
 
-    std::vector<expr> enum_type::get_all_instances() const noexcept
+    size_t enum_type::count_all_instances() const noexcept
     {
-        std::vector<expr> c_instances;
-        for (const auto &i : instances)
-            c_instances.emplace_back(i);
-
+        size_t n = instances.size();
         for (const auto &es : enums)
-        {
-            std::vector<expr> es_instances = es->get_all_instances();
-            c_instances.reserve(c_instances.size() + es_instances.size());
-            c_instances.insert(c_instances.cend(), es_instances.cbegin(), es_instances.cend());
+            n += es->count_all_instances();
+        return n;
+    }
+
+    domain enum_type::get_all_instances() const noexcept
+    {
+        if (!c_all_instances || c_all_instances->size() != count_all_instances())
+        { // new instances have been created since the last snapshot..
+            std::vector<expr> c_instances(instances);
+            for (const auto &es : enums)
+            {
+                const auto es_instances = es->get_all_instances();
+                c_instances.insert(c_instances.cend(), es_instances->cbegin(), es_instances->cend());
+            }
+            c_all_instances = std::make_shared<const std::vector<expr>>(std::move(c_instances));
         }
-        return c_instances;
+        return c_all_instances;
     }
 } // namespace ratio::core
@@ -0,0 +1,52 @@
+#include "parser.h"
+#include "core.h"
+#include <chrono>
+#include <iostream>
+
+using namespace ratio::core;
+
+/**
+ * Measures the per-statement cost of executing a body, either by cross-casting the riddle nodes at each execution (as the interpreter did before storing the core-side nodes at parse time), through the stored core-side nodes or by running the body compiled, once and for all, into a program.
+ */
+int main(int argc, char const *argv[])
+{
+    const size_t n_stmnts = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const size_t n_rounds = argc > 2 ? std::stoul(argv[2]) : 10000;
+
+    std::vector<std::unique_ptr<const riddle::ast::statement>> stmnts;
+    stmnts.reserve(n_stmnts);
+    for (size_t i = 0; i < n_stmnts; ++i)
+    { // nodes are upcast along their riddle side, as the parser does..
+        std::unique_ptr<const riddle::ast::bool_literal_expression> xpr = std::make_unique<const bool_literal_expression>(riddle::bool_token(0, 0, 0, 0, i % 2));
+        std::unique_ptr<const riddle::ast::return_statement> stmnt = std::make_unique<const return_statement>(std::move(xpr));
+        stmnts.push_back(std::move(stmnt));
+    }
+    const auto c_stmnts = to_core<ratio::core::statement>(stmnts);
+
+    core cr;
+    program p;
+    for (const auto &s : c_stmnts)
+        s->compile(p);
+
+    frame frm(cr);
+    auto ctx = frm.get_context();
+    auto bench = [n_stmnts, n_rounds](const char *name, auto &&execute)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < n_rounds; ++r)
+            execute();
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << elapsed / (n_stmnts * n_rounds) << " ns/statement" << std::endl;
+    };
+
+    bench("cross-cast", [&cr, &ctx, &stmnts]()
+          { for (const auto &s : stmnts)
+                dynamic_cast<const ratio::core::statement &>(*s).execute(cr, ctx); });
+    bench("core-side", [&cr, &ctx, &c_stmnts]()
+          { for (const auto &s : c_stmnts)
+                s->execute(cr, ctx); });
+    bench("compiled", [&cr, &ctx, &p]()
+          { p.run(cr, ctx); });
+
+    return 0;
+}
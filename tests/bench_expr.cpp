@@ -0,0 +1,40 @@
+#include "core.h"
+#include "item.h"
+#include <chrono>
+#include <iostream>
+
+using namespace ratio::core;
+
+/**
+ * Measures the cost of copying vectors of item handles, as done when passing arguments, emplacing variables and copying the instances of a type.
+ * Build with and without the `INTRUSIVE_EXPR` option to compare the intrusive handles against `std::shared_ptr`.
+ */
+int main(int argc, char const *argv[])
+{
+    const size_t n_items = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const size_t n_rounds = argc > 2 ? std::stoul(argv[2]) : 10000;
+
+    core cr;
+    std::vector<expr> items;
+    items.reserve(n_items);
+    for (size_t i = 0; i < n_items; ++i)
+        items.push_back(cr.new_int(static_cast<semitone::I>(i)));
+
+#ifdef INTRUSIVE_EXPR
+    std::cout << "intrusive handles (" << sizeof(expr) << " bytes)" << std::endl;
+#else
+    std::cout << "shared_ptr handles (" << sizeof(expr) << " bytes)" << std::endl;
+#endif
+
+    size_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < n_rounds; ++r)
+    {
+        std::vector<expr> c_items = items; // every copy increments, and every destruction decrements, the counts..
+        checksum += c_items.size();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "copy: " << elapsed / (n_items * n_rounds) << " ns/handle (" << checksum << " handles)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "core.h"
+#include "type.h"
+#include "field.h"
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+using namespace ratio::core;
+
+/**
+ * Resolves a field as the interpreter did before the non-throwing lookups, that is, by throwing at each scope and each supertype which does not contain the field.
+ */
+const field &throwing_get_field(const type &tp, const std::string &name)
+{
+    if (const auto at_f = tp.get_fields().find(name); at_f != tp.get_fields().cend())
+        return *at_f->second;
+
+    try
+    { // if not here, check any enclosing scope
+        return tp.get_scope().get_field(name);
+    }
+    catch (const std::out_of_range &)
+    { // if not in any enclosing scope, check any superclass
+        for (const auto &st : tp.get_supertypes())
+            try
+            {
+                return throwing_get_field(*st, name);
+            }
+            catch (const std::out_of_range &)
+            {
+            }
+    }
+
+    // not found
+    throw std::out_of_range(name);
+}
+
+/**
+ * Measures the cost of resolving the fields of a deep multi-inheritance hierarchy, in which each class inherits from all the classes of the previous level, either through the exception-driven fallthrough or through the non-throwing lookups.
+ */
+int main(int argc, char const *argv[])
+{
+    const size_t depth = argc > 1 ? std::stoul(argv[1]) : 8;
+    const size_t width = argc > 2 ? std::stoul(argv[2]) : 2;
+    const size_t n_rounds = argc > 3 ? std::stoul(argv[3]) : 1000;
+
+    std::stringstream script;
+    for (size_t w = 0; w < width; ++w)
+        script << "class C0_" << w << " { real f0_" << w << "; }\n";
+    for (size_t d = 1; d < depth; ++d)
+        for (size_t w = 0; w < width; ++w)
+        {
+            script << "class C" << d << '_' << w << " : ";
+            for (size_t b = 0; b < width; ++b)
+                script << (b ? ", " : "") << 'C' << d - 1 << '_' << b;
+            script << " { real f" << d << '_' << w << "; }\n";
+        }
+
+    core cr;
+    cr.read(script.str());
+    const type &leaf = cr.get_type("C" + std::to_string(depth - 1) + "_0");
+    const std::string root_field = "f0_" + std::to_string(width - 1); // reached only after visiting the first supertypes..
+    const std::string missing_field = "missing";                      // not found after visiting the whole hierarchy..
+
+    auto bench = [n_rounds](const char *name, auto &&lookup)
+    {
+        size_t found = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < n_rounds; ++r)
+            found += lookup();
+        const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << elapsed / n_rounds << " us/lookup (" << found << " found)" << std::endl;
+    };
+
+    bench("throwing hit", [&leaf, &root_field]()
+          { return &throwing_get_field(leaf, root_field) != nullptr; });
+    bench("find hit", [&leaf, &root_field]()
+          { return leaf.find_field(root_field) != nullptr; });
+    bench("throwing miss", [&leaf, &missing_field]()
+          { try { return &throwing_get_field(leaf, missing_field) != nullptr; } catch (const std::out_of_range &) { return false; } });
+    bench("find miss", [&leaf, &missing_field]()
+          { return leaf.find_field(missing_field) != nullptr; });
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "parser.h"
+#include "memory_buffer.h"
+#include "mapped_file.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace ratio::core;
+
+/**
+ * Measures the cost of parsing a generated riddle script, either through the stream path `core::read` used before reading in place (copying the script into a `std::stringstream` or reading the file through a `std::ifstream`) or in place (through a `memory_buffer` over the script or over the memory-mapped file).
+ */
+int main(int argc, char const *argv[])
+{
+    const size_t n_facts = argc > 1 ? std::stoul(argv[1]) : 100000;
+    const size_t n_rounds = argc > 2 ? std::stoul(argv[2]) : 10;
+    const std::string path = argc > 3 ? argv[3] : "bench_read.rddl";
+
+    std::string script;
+    for (size_t i = 0; i < n_facts; ++i)
+        script += "real x" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+    if (std::ofstream ofs(path, std::ios::binary); ofs)
+        ofs << script;
+    else
+    {
+        std::cerr << "cannot write " << path << std::endl;
+        return 1;
+    }
+
+    auto bench = [&script, n_rounds](const char *name, auto &&read)
+    {
+        size_t n_parsed = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < n_rounds; ++r)
+            n_parsed += read() != nullptr;
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << elapsed / n_rounds << " ms/read, " << script.size() * n_rounds / (elapsed * 1e3) << " MB/s (" << n_parsed << " parsed)" << std::endl;
+    };
+
+    bench("string stream", [&script]()
+          { std::stringstream ss(script);
+            parser prs(ss);
+            return prs.parse(); });
+    bench("string in place", [&script]()
+          { memory_buffer buf(script);
+            std::istream is(&buf);
+            parser prs(is);
+            return prs.parse(); });
+    bench("file stream", [&path]()
+          { std::ifstream ifs(path);
+            parser prs(ifs);
+            return prs.parse(); });
+    bench("file mapped", [&path]()
+          { mapped_file mf(path);
+            memory_buffer buf(mf.get_content());
+            std::istream is(&buf);
+            parser prs(is);
+            return prs.parse(); });
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -1,5 +1,22 @@
 #include "combinations.h"
 #include "cartesian_product.h"
+#include "memory_buffer.h"
+#include "symbol_map.h"
+#include "item_pool.h"
+#include "core.h"
+#include "ast_serializer.h"
+#include "item.h"
+#include "atom.h"
+#include "predicate.h"
+#include "field.h"
+#include <istream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <string>
+#include <map>
+#include <unordered_set>
 #include <cassert>
 
 using namespace ratio;
@@ -24,8 +41,646 @@ void test_cartesian_product()
     assert(prod.at(3) == std::vector<char>({'b', 'd'}));
 }
 
+void test_memory_buffer()
+{
+    std::string_view script("real a = 5;");
+    core::memory_buffer buf(script);
+    std::istream is(&buf);
+    std::string tk;
+    is >> tk;
+    assert(tk == "real");
+    is >> tk;
+    assert(tk == "a");
+    is.seekg(0);
+    std::string line;
+    std::getline(is, line);
+    assert(line == script);
+    assert(is.eof());
+}
+
+void test_symbol_map()
+{
+    assert(core::symbol("this") == core::this_sym);
+    assert(core::symbol("a") == core::symbol(std::string("a")));
+    assert(core::symbol("a").str() == "a");
+    assert(&core::symbol("a").str() == &core::symbol("a").str()); // symbols refer to the interned text..
+    assert(core::this_sym.str() == "this" && core::tau_sym.str() == "tau");
+    assert(core::symbol(core::symbol("a").get_id()) == core::symbol("a"));
+    assert(core::symbol::find("a") == core::symbol("a"));
+    assert(!core::symbol::find("never_interned"));
+
+    core::core cr;
+    cr.read(std::string("class A { real f; }\n"));
+    assert(cr.get_type("A").find_field("f"));
+    assert(!cr.get_type("A").find_field("never_declared"));
+    assert(!cr.get("never_declared"));
+    assert(!core::symbol::find("never_declared")); // looking up missing names does not intern them..
+
+    core::symbol_map<int> m;
+    for (int i = 0; i < 100; ++i) // grows beyond the linear limit..
+        assert(m.emplace(core::symbol("x" + std::to_string(i)), i).second);
+    assert(!m.emplace(core::symbol("x42"), 0).second);
+    assert(m.size() == 100);
+    for (int i = 0; i < 100; ++i)
+        assert(m.at(core::symbol("x" + std::to_string(i))) == i);
+    assert(!m.count(core::symbol("y")));
+    assert(m.find(core::symbol("y")) == m.cend());
+    int i = 0;
+    for (const auto &[sym, val] : m) // the entries are iterated in insertion order..
+        assert(sym.str() == "x" + std::to_string(i) && val == i++);
+}
+
+void test_item_pool()
+{
+    core::item_pool pool; // the pool outlives the objects allocated from it..
+    auto a = std::allocate_shared<std::string>(core::pool_allocator<std::string>(pool), "a");
+    auto b = std::allocate_shared<std::string>(core::pool_allocator<std::string>(pool), "b");
+    assert(*a == "a" && *b == "b");
+    assert(pool.get_chunks() == 1);
+
+    const std::string *b_addr = b.get();
+    b.reset();
+    auto c = std::allocate_shared<std::string>(core::pool_allocator<std::string>(pool), "c");
+    assert(c.get() == b_addr); // the deallocated block is reused..
+    assert(pool.get_blocks() == 2);
+    a.reset();
+    c.reset();
+    assert(pool.get_blocks() == 0); // the pool can be safely destroyed..
+}
+
+bool is_constant(const core::expr &x, const semitone::rational &val)
+{ // folded constants are new items, hence they are compared by value..
+    const auto &l = static_cast<core::arith_item &>(*x).get_value();
+    return l.vars.empty() && l.known_term == val;
+}
+
+void test_constant_folding()
+{
+    core::core cr;
+    assert(is_constant(cr.fold_add({cr.new_int(2), cr.new_int(3)}), semitone::rational(5)));
+    assert(is_constant(cr.fold_sub({cr.new_int(2), cr.new_int(3)}), semitone::rational(-1)));
+    assert(is_constant(cr.fold_mult({cr.new_int(10), cr.new_int(60)}), semitone::rational(600)));
+    assert(&cr.fold_mult({cr.new_int(10), cr.new_int(60)})->get_type() == &cr.get_int_type());
+    assert(is_constant(cr.fold_div({cr.new_real(semitone::rational(1)), cr.new_real(semitone::rational(4))}), semitone::rational(1, 4)));
+    assert(!cr.fold_div({cr.new_int(1), cr.new_int(0)})); // division by zero is left to `div`, which cannot build it..
+    assert(is_constant(cr.fold_minus(cr.new_int(3)), semitone::rational(-3)));
+
+    assert(cr.fold_lt(cr.new_int(1), cr.new_int(2)) == cr.new_bool(true));
+    assert(cr.fold_leq(cr.new_int(2), cr.new_int(1)) == cr.new_bool(false));
+    assert(cr.fold_eq(cr.new_int(2), cr.new_real(semitone::rational(2))) == cr.new_bool(true));
+    assert(cr.fold_eq(cr.new_bool(true), cr.new_bool(false)) == cr.new_bool(false));
+    assert(cr.fold_geq(cr.new_int(2), cr.new_int(2)) == cr.new_bool(true));
+    assert(cr.fold_gt(cr.new_int(2), cr.new_int(2)) == cr.new_bool(false));
+}
+
+class comparing_core : public core::core
+{
+public:
+    ratio::core::expr lt(const ratio::core::expr &, const ratio::core::expr &) noexcept override
+    {
+        n_lt++;
+        return new_bool(true);
+    }
+    ratio::core::expr add(const std::vector<ratio::core::expr> &exprs) noexcept override
+    {
+        n_add++;
+        return core::add(exprs);
+    }
+    ratio::core::expr conj(const std::vector<ratio::core::expr> &) noexcept override
+    {
+        n_conj++;
+        return new_bool(false);
+    }
+
+    size_t n_lt = 0, n_add = 0, n_conj = 0;
+};
+
+void test_folding_extension_points()
+{
+    comparing_core cr;
+    const ratio::core::expr x(new ratio::core::arith_item(cr.get_real_type(), semitone::lin(1, semitone::rational(1))));
+    assert(cr.fold_lt(cr.new_int(1), cr.new_int(2)) == cr.new_bool(true));
+    assert(cr.fold_add({cr.new_int(1), cr.new_int(2)}));
+    assert(cr.n_lt == 0 && cr.n_add == 0); // constants are folded without invoking the overrides..
+    assert(cr.fold_lt(x, cr.new_int(2)));
+    assert(cr.fold_add({x, cr.new_int(2)}));
+    assert(cr.n_lt == 1 && cr.n_add == 1);
+
+    const ratio::core::expr p(new ratio::core::bool_item(cr.get_bool_type(), semitone::lit(1)));
+    const ratio::core::expr q(new ratio::core::bool_item(cr.get_bool_type(), semitone::lit(2)));
+    assert(cr.fold_conj({p, cr.new_bool(true)}) == p);
+    assert(cr.n_conj == 0); // a single remaining conjunct does not invoke the override..
+    assert(cr.fold_conj({p, q}) == cr.new_bool(false));
+    assert(cr.n_conj == 1);
+}
+
+void test_literal_interning()
+{
+    core::core cr;
+    assert(cr.new_int(1) != cr.new_int(1)); // only the literals of the riddle code are interned..
+    cr.read(std::string("real a = 1.5;\nreal b = 1.5;\nstring c = \"s\";\nstring d = \"s\";\nint e = 2 + 3;\n"));
+    assert(cr.get("a") == cr.get("b"));
+    assert(cr.get("c") == cr.get("d"));
+    assert(is_constant(cr.get("e"), semitone::rational(5)));
+}
+
+void test_boolean_simplification()
+{
+    core::core cr;
+    const auto t = cr.new_bool(true), f = cr.new_bool(false);
+    assert(cr.fold_negate(t) == f);
+    assert(cr.fold_conj({t, t}) == t);
+    assert(cr.fold_conj({t, f}) == f);
+    assert(cr.fold_disj({f, f}) == f);
+    assert(cr.fold_exct_one({t, f}) == t);
+    assert(cr.fold_exct_one({t, t}) == f);
+    assert(cr.fold_exct_one({f, f}) == f);
+
+    const core::expr x(new core::bool_item(cr.get_bool_type(), semitone::lit(1)));
+    const core::expr not_x(new core::bool_item(cr.get_bool_type(), !semitone::lit(1)));
+    assert(cr.fold_conj({x, t, x}) == x);
+    assert(cr.fold_conj({x, not_x}) == f);
+    assert(cr.fold_disj({x, f}) == x);
+    assert(cr.fold_disj({not_x, x}) == t);
+    assert(cr.fold_exct_one({f, x}) == x);
+    assert(cr.fold_exct_one({x, t, not_x}) == f);
+}
+
+void test_expr_table()
+{
+    core::core cr;
+    const core::expr x(new core::arith_item(cr.get_real_type(), semitone::lin(1, semitone::rational(1))));
+    const core::expr y(new core::arith_item(cr.get_real_type(), semitone::lin(2, semitone::rational(1))));
+    assert(!cr.is_expr_sharing());
+    assert(cr.fold_add({x, y}) != cr.fold_add({x, y})); // expressions are not shared by default..
+    assert(cr.get_expr_table_stats().misses == 0);
+
+    cr.set_expr_sharing(true);
+    const auto x_plus_y = cr.fold_add({x, y});
+    assert(cr.get_expr_table_stats().misses == 1);
+    assert(cr.fold_add({x, y}) == x_plus_y);
+    assert(cr.fold_add({y, x}) == x_plus_y); // the sum is commutative..
+    assert(cr.get_expr_table_stats().hits == 2);
+    assert(cr.fold_add({x, x}) != x_plus_y);
+    assert(cr.get_expr_table_stats().misses == 2);
+
+    // a full table evicts its oldest expression..
+    core::expr_table tbl(2);
+    auto build = [&cr, &x, &y]()
+    { return cr.add({x, y}); };
+    const auto lt_x_y = tbl.get(core::expr_op::lt, {x, y}, false, build);
+    const auto leq_x_y = tbl.get(core::expr_op::leq, {x, y}, false, build);
+    tbl.get(core::expr_op::gt, {x, y}, false, build);
+    assert(tbl.size() == 2 && tbl.get_stats().epoch == 0);
+    assert(tbl.get(core::expr_op::leq, {x, y}, false, build) == leq_x_y);
+    assert(tbl.get(core::expr_op::lt, {x, y}, false, build) != lt_x_y); // the evicted expression is built again..
+
+    // after a backtracking, the expressions built before are not reused..
+    tbl.clear();
+    assert(tbl.size() == 0 && tbl.get_stats().epoch == 1);
+    assert(tbl.get_stats().misses == 4 && tbl.get_stats().hits == 1);
+}
+
+class counting_core : public core::core
+{
+public:
+    void assert_facts(std::vector<ratio::core::expr> facts) override
+    {
+        n_calls++;
+        n_facts += facts.size();
+    }
+
+    size_t n_calls = 0, n_facts = 0;
+};
+
+void test_fact_batch()
+{
+    counting_core cr;
+    {
+        core::fact_batch batch(cr);
+        cr.assert_fact(cr.new_bool(true)); // the default policy is eager..
+        assert(cr.n_calls == 1);
+    }
+
+    cr.set_fact_flush_policy(core::fact_flush_policy::per_body);
+    {
+        core::fact_batch batch(cr);
+        cr.assert_fact(cr.new_bool(true));
+        {
+            core::fact_batch nested(cr);
+            cr.assert_fact(cr.new_bool(true));
+        } // the facts of the nested batch are discarded, since it has not been flushed..
+        cr.assert_fact(cr.new_bool(true));
+        assert(cr.n_calls == 1);
+        batch.flush();
+        assert(cr.n_calls == 2 && cr.n_facts == 3);
+    }
+    cr.assert_fact(cr.new_bool(true)); // outside of any batch, facts are asserted right away..
+    assert(cr.n_calls == 3 && cr.n_facts == 4);
+
+    {
+        core::fact_batch a(cr);
+        cr.assert_fact(cr.new_bool(true));
+        cr.assert_fact(cr.new_bool(true));
+        try
+        {
+            core::fact_batch b(cr);
+            {
+                core::fact_batch c(cr);
+                cr.assert_fact(cr.new_bool(true));
+                c.flush();
+                assert(cr.n_calls == 3); // the facts of a nested batch are handed over to the enclosing batch..
+            }
+            cr.assert_fact(cr.new_bool(true));
+            throw core::inconsistency_exception();
+        }
+        catch (const core::inconsistency_exception &)
+        { // the facts of the failed batch, including those of its flushed nested batch, are discarded..
+        }
+        a.flush();
+        assert(cr.n_calls == 4 && cr.n_facts == 6);
+    }
+}
+
+void test_ast_cache()
+{
+    const std::string script("class A { real f; }\nreal a = 5;\n");
+    std::ostringstream cache_path;
+    cache_path << "./" << std::hex << std::setw(16) << std::setfill('0') << core::content_hash(script) << ".rcu";
+    std::remove(cache_path.str().c_str());
+
+    core::core cr;
+    cr.set_cache_dir(".");
+    cr.read(script);
+
+    std::ifstream ifs(cache_path.str(), std::ios::binary);
+    const std::string data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    ifs.close();
+    auto cu = core::read_compilation_unit(data, script);
+    assert(cu);
+    std::ostringstream os;
+    core::write_compilation_unit(os, script, *cu);
+    assert(os.str() == data);                                  // the compilation unit survives the round-trip..
+    assert(!core::read_compilation_unit(data, script + "\n")); // the entry belongs to a different content..
+    bool malformed = false;
+    try
+    {
+        core::read_compilation_unit(data.substr(0, data.size() - 1), script);
+    }
+    catch (const std::invalid_argument &)
+    {
+        malformed = true;
+    }
+    assert(malformed);
+
+    std::ofstream(cache_path.str(), std::ios::binary | std::ios::trunc) << data.substr(0, data.size() / 2); // we corrupt the entry..
+    core::core c_cr;
+    c_cr.set_cache_dir(".");
+    c_cr.read(script); // the corrupted entry is ignored, and the script is parsed again..
+    assert(c_cr.find_type("A"));
+    std::remove(cache_path.str().c_str());
+}
+
+void test_reload()
+{
+    const std::string path("test_reload.rddl");
+    std::ofstream(path, std::ios::trunc) << "real f() { return 1.0; }\nreal y = f();\n";
+
+    core::core cr;
+    cr.read(std::vector<std::string>({path}));
+    assert(static_cast<core::arith_item &>(*cr.get("y")).get_value().known_term == semitone::rational(1));
+
+    // we move the method down and edit its body, so that the positions of all its tokens change..
+    std::ofstream(path, std::ios::trunc) << "// the method now returns two..\n\nreal f()\n{\n    real two = 2.0;\n    return two;\n}\nreal y = f();\nreal z = f();\n";
+    assert(cr.reload(path));
+    assert(static_cast<core::arith_item &>(*cr.get("y")).get_value().known_term == semitone::rational(1));
+    assert(static_cast<core::arith_item &>(*cr.get("z")).get_value().known_term == semitone::rational(2)); // the appended statement runs the new body..
+
+    std::ofstream(path, std::ios::trunc) << "real f(real x) { return x; }\nreal y = f(1.0);\n";
+    assert(!cr.reload(path)); // the signature of the method has changed..
+
+    counting_core c_cr;
+    c_cr.set_fact_flush_policy(core::fact_flush_policy::per_body);
+    std::ofstream(path, std::ios::trunc) << "1 < 2;\n";
+    c_cr.read(std::vector<std::string>({path}));
+    assert(c_cr.n_calls == 1 && c_cr.n_facts == 1);
+    std::ofstream(path, std::ios::trunc) << "1 < 2;\n2 < 3;\n3 < 4;\n";
+    assert(c_cr.reload(path));
+    assert(c_cr.n_calls == 2 && c_cr.n_facts == 3); // the appended facts are asserted as a batch..
+    std::remove(path.c_str());
+}
+
+void test_streaming_errors()
+{
+    core::core cr;
+    cr.set_streaming(true);
+    std::string err;
+    try
+    {
+        cr.read(std::string("real a = 1;\nreal b = 2; real c = 3;\n\n// the next statement is malformed..\nreal d = ;\n"));
+    }
+    catch (const std::invalid_argument &e)
+    {
+        err = e.what();
+    }
+    assert(err.rfind("line 5: ", 0) == 0); // the error is reported at the line of the script, rather than of the chunk..
+    assert(cr.get("c"));                   // the statements preceding the error have been executed..
+}
+
+void test_streaming_cache()
+{
+    const std::string path("test_streaming.rddl");
+    std::ofstream(path, std::ios::trunc) << "class A { real f; }\nreal a = 1;\n";
+    auto cache_path = [](const std::string &chunk)
+    {
+        std::ostringstream os;
+        os << "./" << std::hex << std::setw(16) << std::setfill('0') << core::content_hash(chunk) << ".rcu";
+        return os.str();
+    };
+    std::remove(cache_path("class A { real f; }").c_str());
+
+    core::core cr;
+    cr.set_cache_dir(".");
+    cr.set_streaming(true);
+    cr.read(std::vector<std::string>({path}));
+    assert(cr.get("a"));
+    assert(std::ifstream(cache_path("class A { real f; }")));   // the declarations are cached..
+    assert(!std::ifstream(cache_path("real a = 1;"))); // the statements are parsed in place..
+    std::remove(cache_path("class A { real f; }").c_str());
+
+    bool unavailable = false;
+    try
+    {
+        cr.reload(path);
+    }
+    catch (const std::invalid_argument &)
+    { // the statements of the streamed file have been released, hence it cannot be reloaded..
+        unavailable = true;
+    }
+    assert(unavailable);
+    std::remove(path.c_str());
+}
+
+void test_new_atoms()
+{
+    core::core cr;
+    cr.read(std::string("predicate P(real x, int y) {}\npredicate Q(real z) : P {}\n"));
+    auto &p = cr.get_predicate("P");
+    auto &q = cr.get_predicate("Q");
+
+    const std::vector<core::expr> xs{cr.new_real(semitone::rational(1)), cr.new_real(semitone::rational(2)), cr.new_real(semitone::rational(3))};
+    const std::vector<core::expr> zs{cr.new_real(semitone::rational(4)), cr.new_real(semitone::rational(5)), cr.new_real(semitone::rational(6))};
+    const auto atms = cr.new_atoms(q, 3, {"x", "z"}, {xs, zs});
+    assert(atms.size() == 3);
+    for (size_t i = 0; i < atms.size(); ++i)
+    {
+        assert(&atms[i]->get_type() == &q);
+        auto &atm = static_cast<core::atom &>(*atms[i]);
+        assert(atm.get(core::symbol("x")) == xs[i]); // the inherited arguments are taken from their columns..
+        assert(atm.get(core::symbol("z")) == zs[i]);
+    }
+    assert(q.get_instances() == atms);
+    assert(p.get_instances() == atms); // the atoms are instances of the super-predicates too..
+
+    bool thrown = false;
+    try
+    {
+        cr.new_atoms(q, 2, {"x"}, {xs}); // the column has not two values..
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    thrown = false;
+    try
+    {
+        cr.new_atoms(q, 1, {"x"}, {{cr.new_string("a")}}); // a string cannot be assigned to a real..
+    }
+    catch (const core::inconsistency_exception &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(q.get_instances().size() == 3);
+}
+
+class filtering_core : public core::core
+{
+public:
+    using ratio::core::core::enum_value;
+    using ratio::core::core::new_enum;
+    ratio::core::expr new_enum(ratio::core::type &tp, const std::vector<ratio::core::expr> &allowed_vals) override
+    {
+        auto e = new_item<ratio::core::enum_item>(tp, static_cast<semitone::var>(domains.size()));
+        domains.emplace(e.get(), std::unordered_set<ratio::core::expr>(allowed_vals.cbegin(), allowed_vals.cend()));
+        return e;
+    }
+    std::unordered_set<ratio::core::expr> enum_value(const ratio::core::enum_item &x) const noexcept override { return domains.at(&x); }
+    void remove(ratio::core::expr &var, ratio::core::expr &val) override { domains.at(static_cast<ratio::core::enum_item *>(var.get())).erase(val); }
+
+    std::map<const ratio::core::enum_item *, std::unordered_set<ratio::core::expr>> domains; // the current domains of the enumerative variables..
+};
+
+void test_atom_instantiation()
+{
+    filtering_core cr;
+    cr.read(std::string("class A {}\nclass B : A {}\npredicate P(B b) {}\n"));
+    const auto a0 = cr.get_type("A").new_instance();
+    const auto b0 = cr.get_type("B").new_instance();
+
+    // the values of an enumerative argument which cannot be assigned to the argument are removed..
+    auto x = cr.get_type("A").new_existential();
+    assert(cr.enum_value(x).size() == 2);
+    cr.new_atoms(cr.get_predicate("P"), 1, {"b"}, {{x}});
+    assert(cr.enum_value(x) == std::unordered_set<core::expr>{b0});
+
+    // formula statements share the same instantiation..
+    auto y = cr.get_type("A").new_existential();
+    cr.set(core::symbol("y"), y);
+    cr.read(std::string("fact f = new P(b: y);\n"));
+    assert(cr.enum_value(y) == std::unordered_set<core::expr>{b0});
+    assert(static_cast<core::atom &>(*cr.get("f")).get(core::symbol("b")) == y);
+}
+
+void test_type_hierarchy()
+{
+    core::core cr;
+    std::string script("class A {}\nclass B : A {}\nclass T0 {}\n");
+    for (int i = 1; i < 70; ++i) // the ancestors span more than one word..
+        script += "class T" + std::to_string(i) + " : T" + std::to_string(i - 1) + " {}\n";
+    cr.read(script);
+    auto &a = cr.get_type("A");
+    auto &b = cr.get_type("B");
+    assert(a.is_assignable_from(b) && b.is_assignable_from(b));
+    assert(!b.is_assignable_from(a));
+    assert(cr.get_type("T0").is_assignable_from(cr.get_type("T69")));
+    assert(!cr.get_type("T69").is_assignable_from(cr.get_type("T0")));
+    assert(!a.is_assignable_from(cr.get_type("T69")));
+    assert(cr.get_type("T69").get_ancestors().size() == 70);
+    assert(cr.get_int_type().is_assignable_from(cr.get_time_type()) && !cr.get_int_type().is_assignable_from(cr.get_real_type()));
+
+    cr.read(std::string("class C {}\nclass D : B, C {}\n")); // the new types and supertypes invalidate the encoding..
+    auto &c = cr.get_type("C");
+    auto &d = cr.get_type("D");
+    assert(a.is_assignable_from(d) && b.is_assignable_from(d) && c.is_assignable_from(d));
+    assert(!d.is_assignable_from(a) && !c.is_assignable_from(b));
+    assert(d.get_ancestors().size() == 4);
+    assert(a.get_ancestors().size() == 1); // the ancestors of the existing types are unchanged..
+}
+
+class test_type : public core::type
+{
+public:
+    test_type(core::scope &scp, const std::string &name) : type(scp, name) {}
+
+    void add_field(const std::string &name, type &tp) { new_field(std::make_unique<core::field>(tp, name)); }
+    void add_supertype(type &t) { new_supertype(t); }
+};
+
+class hierarchy_core : public core::core
+{
+public:
+    test_type &add_type(const std::string &name)
+    { // types are added programmatically, so that their fields and supertypes can change after their instances have been created..
+        auto tp = std::make_unique<test_type>(*this, name);
+        auto &c_tp = *tp;
+        new_type(std::move(tp));
+        return c_tp;
+    }
+};
+
+void test_slot_layouts()
+{
+    hierarchy_core cr;
+    auto &a = cr.add_type("A");
+    auto &b = cr.add_type("B");
+    a.add_field("f", cr.get_real_type());
+    b.add_supertype(a);
+    b.add_field("g", cr.get_real_type());
+    const core::symbol f("f"), g("g"), h("h");
+    assert(a.get_layout().size() == 1);
+    assert(b.get_layout().size() == 2);
+    assert(b.find_inherited_field(f) == a.find_inherited_field(f)); // the inherited fields are laid out within the subtypes..
+    assert(!a.find_inherited_field(g));
+
+    const auto b0 = b.new_instance();
+    auto &c_b0 = static_cast<core::complex_item &>(*b0);
+    const auto x = cr.new_real(semitone::rational(1)), y = cr.new_real(semitone::rational(2));
+    assert(c_b0.set_var(f, x) && !c_b0.set_var(f, y));
+    assert(c_b0.find_var(f) == x && !c_b0.find_var(g));
+
+    a.add_field("h", cr.get_real_type()); // the new field invalidates the layouts of the type and of its subtypes..
+    assert(a.get_layout().size() == 2);
+    assert(b.get_layout().size() == 3);
+    assert(b.find_inherited_field(h));
+
+    assert(c_b0.set_var(h, y)); // the existing instance keeps its layout, storing the new field by name..
+    assert(c_b0.find_var(f) == x && c_b0.find_var(h) == y);
+    const auto vars = c_b0.get_vars();
+    assert(vars.size() == 2 && vars[0].first == f && vars[1].first == h);
+
+    const auto b1 = b.new_instance();
+    auto &c_b1 = static_cast<core::complex_item &>(*b1);
+    assert(c_b1.set_var(h, x) && c_b1.set_var(g, y));
+    const auto c_vars = c_b1.get_vars(); // the new instance lays out the new field, listing the fields in slot order..
+    assert(c_vars.size() == 2 && c_vars[0].first == g && c_vars[1].first == h);
+}
+
+void test_ancestors_and_instances()
+{
+    hierarchy_core cr;
+    auto &a = cr.add_type("A");
+    auto &b = cr.add_type("B");
+    auto &c = cr.add_type("C");
+    b.add_supertype(a);
+    c.add_supertype(b);
+    c.add_supertype(a); // the ancestors appear once..
+    assert(a.get_ancestors() == std::vector<core::type *>({&a}));
+    assert(b.get_ancestors() == std::vector<core::type *>({&b, &a}));
+    assert(c.get_ancestors() == std::vector<core::type *>({&c, &b, &a}));
+
+    auto &d = cr.add_type("D");
+    b.add_supertype(d); // the new supertype invalidates the ancestors of the type and of its subtypes..
+    assert(b.get_ancestors() == std::vector<core::type *>({&b, &a, &d}));
+    assert(c.get_ancestors() == std::vector<core::type *>({&c, &b, &a, &d}));
+    assert(d.is_assignable_from(c));
+
+    const auto c0 = c.new_instance();
+    const auto b0 = b.new_instance();
+    assert(c.get_instances() == std::vector<core::expr>({c0})); // the instances are added to the ancestors too..
+    assert(b.get_instances() == std::vector<core::expr>({c0, b0}));
+    assert(a.get_instances() == b.get_instances() && d.get_instances() == b.get_instances());
+
+    const auto n_instances = a.get_instances().size(); // the view has to be fetched again after creating new instances..
+    const auto a0 = a.new_instance();
+    assert(a.get_instances().size() == n_instances + 1 && a.get_instances().back() == a0);
+    assert(b.get_instances().size() == n_instances);
+}
+
+class domain_core : public hierarchy_core
+{
+public:
+    using ratio::core::core::new_enum;
+    ratio::core::expr new_enum(ratio::core::type &, const ratio::core::domain &allowed_vals) override
+    {
+        domains.push_back(allowed_vals);
+        return nullptr;
+    }
+
+    std::vector<ratio::core::domain> domains; // the initial domains of the created enums..
+};
+
+void test_domain_snapshots()
+{
+    domain_core cr;
+    auto &a = cr.add_type("A");
+    a.new_instance();
+    a.new_instance();
+    a.new_existential();
+    a.new_existential();
+    assert(cr.domains.size() == 2 && cr.domains[0]->size() == 2);
+    assert(cr.domains[0] == cr.domains[1]); // the existentials share the snapshot..
+    assert(a.get_domain() == cr.domains[0]);
+
+    const auto a2 = a.new_instance(); // the new instance invalidates the snapshot, which is left untouched..
+    a.new_existential();
+    assert(cr.domains[2] != cr.domains[0] && cr.domains[2]->size() == 3 && cr.domains[2]->back() == a2);
+    assert(cr.domains[0]->size() == 2);
+    assert(a.get_domain() == cr.domains[2]);
+
+    cr.read(std::string("enum E {\"a\", \"b\"};\nenum F {\"c\"} | E;\n"));
+    cr.domains.clear();
+    cr.get_type("F").new_instance();
+    cr.get_type("F").new_instance();
+    cr.get_type("E").new_instance();
+    assert(cr.domains.size() == 3);
+    assert(cr.domains[0]->size() == 3 && cr.domains[0] == cr.domains[1]); // the instances of the referenced enums are included..
+    assert(cr.domains[2]->size() == 2);
+}
+
 int main(int, char **)
 {
     test_combinations();
     test_cartesian_product();
+    test_memory_buffer();
+    test_symbol_map();
+    test_ast_cache();
+    test_item_pool();
+    test_constant_folding();
+    test_folding_extension_points();
+    test_literal_interning();
+    test_boolean_simplification();
+    test_expr_table();
+    test_fact_batch();
+    test_reload();
+    test_streaming_errors();
+    test_streaming_cache();
+    test_new_atoms();
+    test_atom_instantiation();
+    test_type_hierarchy();
+    test_slot_layouts();
+    test_ancestors_and_instances();
+    test_domain_snapshots();
 }
\ No newline at end of file